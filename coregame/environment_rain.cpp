@@ -24,6 +24,8 @@
 #include "iface.h"
 #include "icwindow.h"
 #include "sound.h"
+#include "system.h"
+#include "perfstats.h"
 
 namespace Environment
 {
@@ -38,6 +40,8 @@ namespace Environment
     #define MAX_RAIN_GRIDS		16
     #define	MAX_RAIN_BEADS		16
     #define MAX_RAIN_SPLATS		128
+    #define RAIN_BATCH_VERTS  3072     // vertices per fill
+    #define RAIN_GRID_COUNT	  9        // blocks around the camera
 
     // Rain:: initialization Flag
     //
@@ -609,7 +613,7 @@ namespace Environment
     // Rain:: forward references
     //
     struct Type;
-    struct Object;
+    struct Strings;
 
     ///////////////////////////////////////////////////////////////////////////////
     //
@@ -650,7 +654,7 @@ namespace Environment
 
     // live data
     //
-    Array<Object> rains;              // live rain string data
+    extern Strings rains;             // live rain string data
     F32           intensity;          // how intense is this type
     U32           index;              // animating texture index
     U32           objCount;           // how many strings
@@ -873,23 +877,148 @@ namespace Environment
 
     ///////////////////////////////////////////////////////////////////////////////
     //
-    // Rain::Object
+    // Rain::Strings
     //
-    // one for each visible string of drops
+    // one entry per string of drops, kept in parallel arrays so the
+    // per frame update and the vertex fill walk contiguous memory
     //
-	  struct Object
+	  struct Strings
 	  {
-		  F32         height;
-		  F32	        width;
-		  Color	      color;
-		  F32	        spacing[MAX_RAIN_BEADS];	// Parametrized to 0-1 within a block
-		  Vector	    start;					        // Position on a block
-		  Vector	    end;						        // End of string (along direction, blockDist lower)
-		  Vector	    direction;				      // Unit vector
-		  F32	        s;						          // Parameter 0-1, wraps at 1 back to 0
-		  F32	        speed;					        // meters-per-second
-		  F32	        len;						        // length of the string
+		  Array<Vector>	start;					      // Position on a block
+		  Array<Vector>	direction;				    // Unit vector
+		  Array<F32>	  s;						        // Parameter 0-1, wraps at 1 back to 0
+		  Array<F32>	  rate;					        // speed / blockHeight; parameter per second
+		  Array<F32>	  len;						      // length of the string
+		  Array<F32>	  spacing;	            // MAX_RAIN_BEADS per string; parametrized to 0-1 within a block
+
+      Array<Vector> beads;                // count per string; block relative world offsets
+      Array<Vector> view;                 // beads rotated into camera space
+
+      F32           dt;                   // pending simulation time for the worker
+
+      ///////////////////////////////////////////////////////////////////////////////
+      //
+      // Rain::Strings:: function members
+      //
+      void Alloc( U32 n)
+      {
+        start.Alloc( n);
+        direction.Alloc( n);
+        s.Alloc( n);
+        rate.Alloc( n);
+        len.Alloc( n);
+        spacing.Alloc( n * MAX_RAIN_BEADS);
+        beads.Alloc( n * MAX_RAIN_BEADS);
+        view.Alloc( n * MAX_RAIN_BEADS);
+      }
+
+      void Release()
+      {
+        start.Release();
+        direction.Release();
+        s.Release();
+        rate.Release();
+        len.Release();
+        spacing.Release();
+        beads.Release();
+        view.Release();
+      }
+
+      void Simulate();
     };
+    Strings rains;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // Rain::Worker
+    //
+    // rain is non-sync; the string update runs beside the sim
+    // and is collected before the vertex fill
+    //
+    namespace Worker
+    {
+      static VarInteger         enabled;
+
+      static System::Thread *   thread;
+      static System::Event      startEvent;
+      static System::Event      doneEvent;
+      static Bool               quit;
+      static Bool               busy;
+
+      //
+      // Thread procedure
+      //
+      static U32 STDCALL Process( void *)
+      {
+        for (;;)
+        {
+          startEvent.Wait();
+
+          if (quit)
+          {
+            break;
+          }
+          rains.Simulate();
+
+          doneEvent.Signal();
+        }
+        return 0;
+      }
+
+      //
+      // Wait for the update in flight
+      //
+      static void Wait()
+      {
+        if (busy)
+        {
+          doneEvent.Wait();
+          busy = FALSE;
+        }
+      }
+
+      //
+      // Start an update of 'dt' seconds
+      //
+      static void Start( F32 dt)
+      {
+        Wait();
+
+        rains.dt = dt;
+
+        if (thread && *enabled)
+        {
+          busy = TRUE;
+          startEvent.Signal();
+        }
+        else
+        {
+          rains.Simulate();
+        }
+      }
+
+      static void Init()
+      {
+        VarSys::CreateInteger("rain.worker", TRUE, VarSys::DEFAULT, &enabled);
+
+        busy = FALSE;
+        quit = FALSE;
+
+        thread = new System::Thread( Process, NULL);
+      }
+
+      static void Done()
+      {
+        Wait();
+
+        quit = TRUE;
+        startEvent.Signal();
+
+        // waits for the thread to exit
+        delete thread;
+        thread = NULL;
+      }
+    }
 
     ///////////////////////////////////////////////////////////////////////////////
     //
@@ -903,6 +1032,9 @@ namespace Environment
     //
     void Setup()
     {
+      // the worker may be reading the type and the strings
+      Worker::Wait();
+
       if (!type)
       {
         Splat::ground = NULL;
@@ -946,27 +1078,23 @@ namespace Environment
 
 	    for (U32 j = 0; j < objCount; j++)
 	    {
-		    Object *obj = &rains[j];
-
-		    obj->height			  = type->height;
-		    obj->width			  = type->width;
-		    obj->color        = type->color;
-		    obj->start.x		  = (j%type->grids) * dx + JITTER(dx) + .5f * dx;
-		    obj->start.y		  = type->blockHeight    + JITTER(ds * type->blockHeight * .5f);
-		    obj->start.z		  = (j/type->grids) * dz + JITTER(dz) + .5f * dz;
-		    obj->direction.x	= type->direction.x + JITTER(.2f);
-		    obj->direction.y	= type->direction.y + JITTER(.2f);
-		    obj->direction.z	= type->direction.z + JITTER(.2f);
-		    obj->len			    = type->blockHeight / (F32)fabs(obj->direction.y);
-		    obj->end.x		    = obj->start.x + obj->direction.x * obj->len;
-		    obj->end.y		    = obj->start.y + obj->direction.y * obj->len;
-		    obj->end.z		    = obj->start.z + obj->direction.z * obj->len;
-		    obj->speed		    = type->speed + JITTER(type->speed*0.2f);
-		    obj->s			      = 0;
-
+        Vector & start = rains.start[j];
+        Vector & dir   = rains.direction[j];
+
+		    start.x		  = (j%type->grids) * dx + JITTER(dx) + .5f * dx;
+		    start.y		  = type->blockHeight    + JITTER(ds * type->blockHeight * .5f);
+		    start.z		  = (j/type->grids) * dz + JITTER(dz) + .5f * dz;
+		    dir.x	      = type->direction.x + JITTER(.2f);
+		    dir.y	      = type->direction.y + JITTER(.2f);
+		    dir.z	      = type->direction.z + JITTER(.2f);
+		    rains.len[j]  = type->blockHeight / (F32)fabs(dir.y);
+		    rains.rate[j] = (type->speed + JITTER(type->speed*0.2f)) / type->blockHeight;
+		    rains.s[j]    = 0;
+
+        F32 * spacing = &rains.spacing[j * MAX_RAIN_BEADS];
 		    for (U32 k = 0; k < MAX_RAIN_BEADS; k++)
         {
-			    obj->spacing[k] = k * ds + JITTER(ds*0.5f);
+			    spacing[k] = k * ds + JITTER(ds*0.5f);
         }
 	    }
 
@@ -1083,6 +1211,34 @@ namespace Environment
         Strike();
         break;
 
+      case 0x0B6C94D1: // "rain.benchmark"
+      {
+        // heavy storm density scene: rain.benchmark [grids] [count]
+        //
+        S32 g = MAX_RAIN_GRIDS, c = MAX_RAIN_BEADS;
+        Console::GetArgInteger(1, g);
+        Console::GetArgInteger(2, c);
+
+        if (!type)
+        {
+          if (!typeList.Find( Crc::CalcStr( "benchmark")))
+          {
+            new Type( "benchmark");
+          }
+          typeVar = "benchmark";
+        }
+        gridsVar = g;
+        countVar = c;
+        active = TRUE;
+
+        if (type)
+        {
+          CON_DIAG(("[%s] %u strings, %u drops per frame", type->name.str, 
+            objCount * RAIN_GRID_COUNT, objCount * type->count * RAIN_GRID_COUNT))
+        }
+        break;
+      }
+
       case 0xD91505BB: // "rain.delete"
         if (type)
         {
@@ -1113,6 +1269,7 @@ namespace Environment
         if (Crc::CalcStr( *typeVar) == 0xC9EF9119) // "none"
         {
           active = FALSE;
+          Worker::Wait();
           type = NULL;
           Setup();
           break;
@@ -1127,6 +1284,7 @@ namespace Environment
           effect->StopByEffect(); 
           soundoff = TRUE;
         }
+        Worker::Wait();
         type = newType;
 
         Setup();
@@ -1148,6 +1306,9 @@ namespace Environment
         // fall through
 
       default:
+        // the type vars are written before Setup gets a chance to wait
+        Worker::Wait();
+
         if (type && type->CmdHandler( pathCrc))
         {
           Setup();
@@ -1198,6 +1359,7 @@ namespace Environment
 
       VarSys::CreateCmd("rain.report");
       VarSys::CreateCmd("rain.strike");
+      VarSys::CreateCmd("rain.benchmark");
       VarSys::CreateCmd("rain.listtypes");
       VarSys::CreateCmd("rain.create");
       VarSys::CreateCmd("rain.delete");
@@ -1233,6 +1395,9 @@ namespace Environment
 
 	    // One time initialization
       rains.Alloc( MAX_RAIN_GRIDS * MAX_RAIN_GRIDS);
+      objCount = 0;
+
+      Worker::Init();
 
       strikeCounter = 0;
       intensity = 1.0f;
@@ -1260,8 +1425,11 @@ namespace Environment
         soundoff = TRUE;
       }
 
+      Worker::Wait();
+
       Splat::Done();
 
+      Worker::Done();
       rains.Release();
 
       delete effect;
@@ -1315,11 +1483,7 @@ namespace Environment
       F32 dt = GameTime::SimTime();
 
 	    // Process offset along each string
-	    for (U32 j = 0; j < objCount; j++)
-	    {
-		    Object * obj = &rains[j];
-		    obj->s = (F32)fmod( obj->s + dt * (obj->speed/type->blockHeight), 1.);
-	    }
+      Worker::Start( dt);
 
       // texture animation
       texAnim += dt * type->animRate;
@@ -1338,6 +1502,47 @@ namespace Environment
       }
     }
 
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // Rain::Strings::Simulate
+    //
+    // advance every string by 'dt' and lay out its beads relative to the block
+    //
+    void Strings::Simulate()
+    {
+      U32 j, k, n = objCount, c = type->count;
+
+      Vector * b = beads.data;
+      for (j = 0; j < n; j++)
+      {
+        F32 u = s.data[j] + dt * rate.data[j];
+        if (u >= 1.0f)
+        {
+          u -= (F32) floor( u);
+        }
+        s.data[j] = u;
+
+        const Vector & p = start.data[j];
+        const Vector & d = direction.data[j];
+        const F32 * sp = spacing.data + j * MAX_RAIN_BEADS;
+        F32 l = len.data[j];
+
+        for (k = 0; k < c; k++, b++)
+        {
+          F32 t = u + sp[k];
+          if (t >= 1.0f)
+          {
+            t -= 1.0f;
+          }
+          t *= l;
+
+          b->x = p.x + d.x * t + jitter[k].x;
+          b->y = p.y + d.y * t;
+          b->z = p.z + d.z * t + jitter[k].z;
+        }
+      }
+    }
+
     ///////////////////////////////////////////////////////////////////////////////
     //
     // Rain::Render
@@ -1352,6 +1557,8 @@ namespace Environment
       {
 		    return;
       }
+      Worker::Wait();
+
       type->Render();
 
       if (type->hasSplats)
@@ -1373,7 +1580,6 @@ namespace Environment
     //
     void Type::Render()
     {
-	    #define RAIN_GRID_COUNT	9
 	    static F32	gridOffset[RAIN_GRID_COUNT][3] =
 	    {
 		    -1.0f, 0.0f,-1.0f,  0.0f, 0.0f,-1.0f,  1.0f, 0.0f,-1.0f,	// around you
@@ -1399,7 +1605,7 @@ namespace Environment
 
 	    // Compute vertices in a triangle aligned along the rain fall direction
 	    // and facing the camera
-	    Vector	p0, p1, p2, dir0, dir1;
+	    Vector	p0, p1, p2, dir0;
       Vid::Math::viewMatrix.Rotate( dir0, type->direction);
 
       // particle size
@@ -1412,6 +1618,15 @@ namespace Environment
         h *= 2;
       }
 
+      // rotate the beads into camera space once; each block is then just a translation
+      U32 beadCount = objCount * count;
+      Vid::Math::viewMatrix.Rotate( rains.view.data, rains.beads.data, beadCount);
+
+      PERF_COUNT("Rain beads", beadCount * RAIN_GRID_COUNT, 0)
+
+      // strings per vertex fill
+      U32 batch = Max<U32>( 1, RAIN_BATCH_VERTS / (count * 3));
+
 	    // Generate the rain drop triangles
 	    for (U32 grid = 0; grid < RAIN_GRID_COUNT; grid++)
 	    {
@@ -1423,157 +1638,145 @@ namespace Environment
 				  gridOffset[grid][2] * type->blockSize   + worldPos.z
         );
 
-		    //Don't draw blocks which are not within camera view
-//		    Vector	blkPos;
-//		    blkPos.Set(blkX+blockCenter.x, blkY+blockCenter.y, blkZ+blockCenter.z);
-//        viewMatrix.Transform( blkPos);
-//		    if (camera.SphereTest(blkPos, blockRadius) != clipOUTSIDE)
-		    {
-			    for (U32 j = 0; j < objCount; j++)
-			    {
-				    Object * obj = &rains[j];
+        // block origin and center in camera space
+        Vector start0, center = blk + blockBounds.Offset();
+        Vid::Math::viewMatrix.Transform( start0, blk);
+        Vid::Math::viewMatrix.Transform( center);
 
-				    // Compute starting point of this string in camera space
-            Vector start0 = blk + obj->start;
-		        Vid::Math::viewMatrix.Transform( start0);
+        for (U32 j0 = 0; j0 < objCount; j0 += batch)
+        {
+          U32 j1 = Min<U32>( j0 + batch, objCount);
 
-            // obj direction in camera space
-		        Vid::Math::viewMatrix.Rotate( dir1, obj->direction);
+          Vid::SetTranBucketZ( center.z, Vid::sortEFFECT0 + 222);
 
-            Vid::SetTranBucketZ( start0.z, Vid::sortEFFECT0 + 222);
+	        // get memory
+          VertexTL * vertmem;
+          if (!Vid::LockPrimitiveMem( (void **) &vertmem, (j1 - j0) * count * 3))
+          {
+            return;
+          }
+          VertexTL vtx0, vtx1, vtx2, * dstV = vertmem;
+
+    			// Generate the beads along these strings
+          const Vector * bead = rains.view.data + j0 * count, * beadEnd = rains.view.data + j1 * count;
+			    for ( ; bead < beadEnd; bead++)
+			    {
+            F32 t;
+            Vector start1 = start0 + *bead;
+            Vid::ProjectFromCamera_II( vtx0, start1);
 
-	          // get memory
-            U32 vCount = count * 4;
-            VertexTL * vertmem;
-            if (!Vid::LockPrimitiveMem( (void **) &vertmem, vCount))
+            if (isRound)
             {
-              return;
-            }
-            VertexTL vtx0, vtx1, vtx2, * dstV = vertmem;
+              if (start1.z < Vid::Math::nearPlane)
+              {
+                // nearplane clip
+                continue;
+              }
+
+              // ...round rain drops (e.g. snow flakes) are aligned to face the camera
+              // don't let drops shrink beyond 2 pix
+              F32 hh = Vid::Project( h, start1.z) < 1 ? Vid::ProjectInv( 1, start1.z) : h;
+              F32 ww = Vid::Project( w, start1.z) < 1 ? Vid::ProjectInv( 1, start1.z) : w;
+
+              vtx1 = vtx0;
+              vtx2 = vtx0;
 
-    			  // Generate the beads along this string
-					  for (U32 k = 0; k < count; k++)
-					  {
-						  // Compute offset along the string and convert it to a position in world space
-						  F32	t = (F32)(obj->len * fmod(obj->s + obj->spacing[k], 1));
+              vtx0.vv.y -= hh;
 
-              Vector start1 = start0 + dir1 * t + jitter[k];
-//              start1 = start0 + dir1 * t;
-              Vid::ProjectFromCamera_II( vtx0, start1);
+              vtx1.vv.x += ww;
+              vtx1.vv.y += hh;
+              
+              vtx2.vv.x -= ww;
+              vtx2.vv.y += hh;
+            }
+            else
+            {
+              Vector end = start1 + dir0 * h;
 
-              if (isRound)
+              // nearplane clip
+              if (start1.z < Vid::Math::nearPlane)
               {
-                if (start1.z < Vid::Math::nearPlane)
+                if (end.z < Vid::Math::nearPlane)
                 {
-                  // nearplane clip
                   continue;
                 }
-
-                // ...round rain drops (e.g. snow flakes) are aligned to face the camera
-                // don't let drops shrink beyond 2 pix
-                F32 hh = Vid::Project( h, start1.z) < 1 ? Vid::ProjectInv( 1, start1.z) : h;
-                F32 ww = Vid::Project( w, start1.z) < 1 ? Vid::ProjectInv( 1, start1.z) : w;
-
-                vtx1 = vtx0;
-                vtx2 = vtx0;
-
-                vtx0.vv.y -= hh;
-
-                vtx1.vv.x += ww;
-                vtx1.vv.y += hh;
-                
-                vtx2.vv.x -= ww;
-                vtx2.vv.y += hh;
+                t = (Vid::Math::nearPlane - start1.z) / (end.z - start1.z);
+                start1 += (end - start1) * t;
+                Vid::ProjectFromCamera_II( vtx0, start1);
               }
-              else
+              else if (end.z < Vid::Math::nearPlane)
               {
-                Vector end = start1 + dir0 * h;
-
-                // nearplane clip
-                if (start1.z < Vid::Math::nearPlane)
-                {
-                  if (end.z < Vid::Math::nearPlane)
-                  {
-                    continue;
-                  }
-                  t = (Vid::Math::nearPlane - start1.z) / (end.z - start1.z);
-                  start1 += (end - start1) * t;
-                  Vid::ProjectFromCamera_II( vtx0, start1);
-                }
-                else if (end.z < Vid::Math::nearPlane)
-                {
-                  t = (Vid::Math::nearPlane - end.z) / (start1.z - end.z);
-                  end += (start1 - end) * t;
-                }
-                Vid::ProjectFromCamera_II( vtx1, end);
+                t = (Vid::Math::nearPlane - end.z) / (start1.z - end.z);
+                end += (start1 - end) * t;
+              }
+              Vid::ProjectFromCamera_II( vtx1, end);
 
-                // don't let drops shrink beyond 2 pix
-                end.x = vtx1.vv.x - vtx0.vv.x;
-                end.y = vtx1.vv.y - vtx0.vv.y;
-                if (fabs( end.x) < 2)
-                {
-                  vtx1.vv.x = vtx0.vv.x + Utils::FSign( end.x) * 2;
-                }
-                if (fabs( end.y) < 2)
-                {
-                  vtx1.vv.y = vtx0.vv.y + Utils::FSign( end.y) * 2;
-                }
-                vtx2 = vtx1;
+              // don't let drops shrink beyond 2 pix
+              end.x = vtx1.vv.x - vtx0.vv.x;
+              end.y = vtx1.vv.y - vtx0.vv.y;
+              if (fabs( end.x) < 2)
+              {
+                vtx1.vv.x = vtx0.vv.x + Utils::FSign( end.x) * 2;
+              }
+              if (fabs( end.y) < 2)
+              {
+                vtx1.vv.y = vtx0.vv.y + Utils::FSign( end.y) * 2;
+              }
+              vtx2 = vtx1;
 
-                Vector dw = dir0 * w;
-                dw.x = -Vid::Project( dw.x, end.z) /* * (cam.front.x > 0 ? -1 : 1)*/;
-                dw.y =  Vid::Project( dw.y, end.z) /* * (cam.front.x > 0 ? -1 : 1)*/;
+              Vector dw = dir0 * w;
+              dw.x = -Vid::Project( dw.x, end.z) /* * (cam.front.x > 0 ? -1 : 1)*/;
+              dw.y =  Vid::Project( dw.y, end.z) /* * (cam.front.x > 0 ? -1 : 1)*/;
 //                dw.x = dw.x < 0 ? Min<F32>( -.5, dw.x) : Max<F32>( .5, dw.x);
 //                dw.y = dw.y < 0 ? Min<F32>( -.5, dw.y) : Max<F32>( .5, dw.y);
 
-                if (cam.front.x > 0)
-                {
-                  vtx1.vv.x -= dw.y;
-                  vtx1.vv.y += dw.x;
+              if (cam.front.x > 0)
+              {
+                vtx1.vv.x -= dw.y;
+                vtx1.vv.y += dw.x;
 
-                  vtx2.vv.x += dw.y;
-                  vtx2.vv.y -= dw.x;
-                }
-                else
-                {
-                  vtx1.vv.x += dw.y;
-                  vtx1.vv.y -= dw.x;
+                vtx2.vv.x += dw.y;
+                vtx2.vv.y -= dw.x;
+              }
+              else
+              {
+                vtx1.vv.x += dw.y;
+                vtx1.vv.y -= dw.x;
 
-                  vtx2.vv.x -= dw.y;
-                  vtx2.vv.y += dw.x;
-                }
+                vtx2.vv.x -= dw.y;
+                vtx2.vv.y += dw.x;
               }
+            }
 
-              dstV->vv  = vtx0.vv;
-              dstV->rhw = vtx0.rhw;
-              dstV->diffuse  = color;
-              dstV->specular = 0xFF000000;
-              dstV->uv.u = 0.5f;
-              dstV->uv.v = 0.0f;
-              dstV++;
-
-              dstV->vv  = vtx1.vv;
-              dstV->rhw = vtx1.rhw;
-              dstV->diffuse  = color;
-              dstV->specular = 0xFF000000;
-              dstV->uv.u = 0.0f;
-              dstV->uv.v = 1.0f;
-              dstV++;
-
-              dstV->vv  = vtx2.vv;
-              dstV->rhw = vtx2.rhw;
-              dstV->diffuse  = color;
-              dstV->specular = 0xFF000000;
-              dstV->uv.u = 1.0f;
-              dstV->uv.v = 1.0f;
-              dstV++;
-
-					  } //...loop over beads on a string
-
-	          Vid::UnlockPrimitiveMem( dstV - vertmem);
-
-  			  } //...loop over rains within grid block
-	  	  } //...if grid block is within viewing volume
+            dstV->vv  = vtx0.vv;
+            dstV->rhw = vtx0.rhw;
+            dstV->diffuse  = color;
+            dstV->specular = 0xFF000000;
+            dstV->uv.u = 0.5f;
+            dstV->uv.v = 0.0f;
+            dstV++;
+
+            dstV->vv  = vtx1.vv;
+            dstV->rhw = vtx1.rhw;
+            dstV->diffuse  = color;
+            dstV->specular = 0xFF000000;
+            dstV->uv.u = 0.0f;
+            dstV->uv.v = 1.0f;
+            dstV++;
+
+            dstV->vv  = vtx2.vv;
+            dstV->rhw = vtx2.rhw;
+            dstV->diffuse  = color;
+            dstV->specular = 0xFF000000;
+            dstV->uv.u = 1.0f;
+            dstV->uv.v = 1.0f;
+            dstV++;
+
+			    } //...loop over beads on the strings
+
+	        Vid::UnlockPrimitiveMem( dstV - vertmem);
+
+  			} //...loop over string batches within grid block
   	  } //...loop over 3x3x2 grid
 
     }
@@ -2130,6 +2333,7 @@ namespace Environment
             {
               const char *s = sScope->NextArgString();
 
+              Worker::Wait();
               type = typeList.Find( Crc::CalcStr( s));
               if (!type)
               {
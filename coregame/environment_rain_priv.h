@@ -111,7 +111,7 @@ namespace Environment
     // Rain:: forward references
     //
     struct Type;
-    struct Object;
+    struct Strings;
 
     ///////////////////////////////////////////////////////////////////////////////
     //
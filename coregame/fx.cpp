@@ -46,8 +46,15 @@ namespace FX
   // available types
   NBinTree<Type> types(&Type::node);
 
-  // Current Objects
-  NList<Object> objects(&Object::node);
+  // Types with active objects
+  NList<SingleType> activeTypes(&SingleType::activeNode);
+
+  // Freed object memory, linked through the first word
+  static void *freeList = NULL;
+  static U32 freeCount = 0;
+
+  // Free all pooled object memory
+  static void ReleasePool();
 
 
   ///////////////////////////////////////////////////////////////////////////////
@@ -61,7 +68,9 @@ namespace FX
   //
   SingleType::SingleType(FScope *fScope) :
     sound(fScope->GetFunction("Sound")),
-    particle(fScope->GetFunction("Particles"))
+    particle(fScope->GetFunction("Particles")),
+    owner(NULL),
+    objects(&Object::node)
   {
     FScope *sScope = fScope->GetFunction("MeshEffect", FALSE);
 
@@ -88,6 +97,12 @@ namespace FX
   //
   SingleType::~SingleType()
   {
+    ASSERT(!objects.GetCount())
+
+    if (activeNode.InUse())
+    {
+      activeTypes.Unlink(this);
+    }
   }
 
 
@@ -131,8 +146,12 @@ namespace FX
   //
   Type::Type(FScope *fScope) :
     defaultType(fScope),
-    surfaceTypes(&SingleType::node)
+    surfaceTypes(&SingleType::node),
+    active(0),
+    highWater(0)
   {
+    defaultType.owner = this;
+
     // Get the optional sample node
     fScope = fScope->GetFunction("SurfaceSample", FALSE);
 
@@ -151,7 +170,9 @@ namespace FX
           case 0x6728DE39: // "Surface"
           {
             const char *surface = StdLoad::TypeString(sScope);
-            surfaceTypes.Add(MoveTable::SurfaceIndex(surface), new SingleType(sScope));
+            SingleType *singleType = new SingleType(sScope);
+            singleType->owner = this;
+            surfaceTypes.Add(MoveTable::SurfaceIndex(surface), singleType);
             break;
           }
         }
@@ -239,12 +260,80 @@ namespace FX
   }
 
 
+  ///////////////////////////////////////////////////////////////////////////////
+  //
+  // Struct View
+  //
+
+
+  //
+  // View::Setup
+  //
+  void View::Setup()
+  {
+    Camera & cam = Vid::CurCamera();
+
+    posit = cam.WorldMatrix().Position();
+    farPlane2 = cam.FarPlane() * cam.FarPlane();
+    team = Team::GetDisplayTeam();
+  }
+
+
   ///////////////////////////////////////////////////////////////////////////////
   //
   // Class Object
   //
 
 
+  //
+  // Object::operator new
+  //
+  // Reuse the memory of dead objects
+  //
+  void * Object::operator new(size_t size)
+  {
+    ASSERT(size == sizeof(Object))
+
+    if (freeList)
+    {
+      void *data = freeList;
+      freeList = *(void **) data;
+      freeCount--;
+      return (data);
+    }
+    return (::operator new(size));
+  }
+
+
+  //
+  // Object::operator delete
+  //
+  void Object::operator delete(void *data)
+  {
+    if (data)
+    {
+      *(void **) data = freeList;
+      freeList = data;
+      freeCount++;
+    }
+  }
+
+
+  //
+  // ReleasePool
+  //
+  static void ReleasePool()
+  {
+    while (freeList)
+    {
+      void *data = freeList;
+      freeList = *(void **) data;
+      ::operator delete(data);
+    }
+    freeCount = 0;
+  }
+
+
   //
   // Object::Object
   //
@@ -257,7 +346,20 @@ namespace FX
     callBack(callBack),
     context(context)
   {
-    objects.Append(this);
+    type->objects.Append(this);
+
+    if (!type->activeNode.InUse())
+    {
+      activeTypes.Append(type);
+    }
+
+    Type *owner = type->owner;
+    ASSERT(owner)
+
+    if (++owner->active > owner->highWater)
+    {
+      owner->highWater = owner->active;
+    }
 
     lifeTime = _lifeTime;
 
@@ -311,7 +413,8 @@ namespace FX
 
     if (node.InUse())
     {
-      objects.Unlink(this);
+      type->objects.Unlink(this);
+      type->owner->active--;
     }
   }
 
@@ -320,6 +423,18 @@ namespace FX
   // Object::Process
   //
   void Object::Process()
+  {
+    View view;
+    view.Setup();
+
+    Process(view);
+  }
+
+
+  //
+  // Object::Process
+  //
+  void Object::Process(const View &view)
   {
     // Is the map object alive ?
     if (!mapObj.Alive() || mapObj->deathNode.InUse())
@@ -340,14 +455,12 @@ namespace FX
     // Work out if this object is in range of the camera
     Bool inRange = FALSE;
 
-    Camera & cam = Vid::CurCamera();
-    F32 farPlane = cam.FarPlane();
-    F32 distance = farPlane * farPlane - mapObj->Mesh().ObjectBounds().Radius2();
-    Vector pos = mapObj->WorldMatrix().Position() - cam.WorldMatrix().Position();
+    F32 distance = view.farPlane2 - mapObj->Mesh().ObjectBounds().Radius2();
+    Vector pos = mapObj->WorldMatrix().Position() - view.posit;
     
     if (pos.Magnitude2() < distance)
     {
-      if (Team::GetDisplayTeam() && mapObj->GetVisible(Team::GetDisplayTeam()))
+      if (view.team && mapObj->GetVisible(view.team))
       {
         inRange = TRUE;
       }
@@ -460,6 +573,23 @@ namespace FX
         New( s, mapo);
         break;
       }
+      case 0x85832E2F: // "effect.pools"
+      {
+        U32 total = 0;
+
+        CON_DIAG(("[Effect Pools]"))
+
+        for (NBinTree<Type>::Iterator i(&types); *i; i++)
+        {
+          if ((*i)->highWater)
+          {
+            CON_DIAG(("%-32s %5d %5d", (*i)->typeId.str, (*i)->active, (*i)->highWater))
+            total += (*i)->active;
+          }
+        }
+        CON_DIAG(("%d active, %d free", total, freeCount))
+        break;
+      }
     }
   }
 
@@ -477,6 +607,7 @@ namespace FX
     // Create commands
     VarSys::CreateCmd("effect.listtypes");
     VarSys::CreateCmd("effect.create");
+    VarSys::CreateCmd("effect.pools");
 
     initialized = TRUE;
   }
@@ -491,6 +622,8 @@ namespace FX
 
     types.DisposeAll();
 
+    ReleasePool();
+
     VarSys::DeleteItem("effect");
 
     initialized = FALSE;
@@ -505,11 +638,23 @@ namespace FX
     ASSERT(initialized)
 
     // Kill of all the objects
-    if (objects.GetCount())
+    for (NList<SingleType>::Iterator t(&activeTypes); *t;)
+    {
+      SingleType *type = t++;
+
+      //LOG_DIAG(("%d FX objects left over", type->objects.GetCount()))
+      type->objects.DisposeAll();
+
+      activeTypes.Unlink(type);
+    }
+
+    // Reset the counts for the next mission
+    for (NBinTree<Type>::Iterator i(&types); *i; i++)
     {
-      //LOG_DIAG(("%d FX objects left over", objects.GetCount()))
-      objects.DisposeAll();
+      (*i)->active = (*i)->highWater = 0;
     }
+
+    ReleasePool();
   }
 
 
@@ -520,12 +665,31 @@ namespace FX
   {
     ASSERT(initialized)
 
-    NList<Object>::Iterator o(&objects);
-    Object *obj;
+    View view;
+    view.Setup();
+
+    // Process each type's objects together
+    NList<SingleType>::Iterator t(&activeTypes);
+    SingleType *type;
 
-    while ((obj = o++) != NULL)
+    while ((type = t++) != NULL)
     {
-      obj->Process();
+      NList<Object>::Iterator o(&type->objects);
+      Object *obj;
+
+      while ((obj = o++) != NULL)
+      {
+        obj->Process(view);
+      }
+    }
+
+    // Drop the types which have run out of objects
+    for (!t; (type = t++) != NULL;)
+    {
+      if (!type->objects.GetCount())
+      {
+        activeTypes.Unlink(type);
+      }
     }
   }
 
@@ -21,6 +21,13 @@
 #include "particlefx_object.h"
 #include "meshfx_object.h"
 
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Forward Declarations
+//
+class Team;
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 // NameSpace FX
@@ -34,6 +41,26 @@ namespace FX
   class SingleType;
 
 
+  ///////////////////////////////////////////////////////////////////////////////
+  //
+  // Struct View - per process camera data shared by all objects
+  //
+  struct View
+  {
+    // Camera position
+    Vector posit;
+
+    // Squared far plane distance
+    F32 farPlane2;
+
+    // Team to test visibility for
+    Team *team;
+
+    // Set up from the current camera
+    void Setup();
+  };
+
+
   ///////////////////////////////////////////////////////////////////////////////
   //
   // Class Object
@@ -73,6 +100,7 @@ namespace FX
 
   public:
 
+    // Node on the type's update list
     NList<Object>::Node node;
 
   public:
@@ -83,6 +111,11 @@ namespace FX
 
     // Process the FX
     void Process();
+    void Process(const View &view);
+
+    // Pooled allocation
+    static void * operator new(size_t size);
+    static void operator delete(void *data);
 
     // Terminate the FX
     void Terminate();
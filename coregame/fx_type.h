@@ -33,6 +33,7 @@ namespace FX
   // forward references
   //
   class Object;
+  class Type;
 
   ///////////////////////////////////////////////////////////////////////////////
   //
@@ -75,6 +76,15 @@ namespace FX
     // Tree node
     NBinTree<SingleType, U8>::Node node;
 
+    // Type which owns this one
+    Type *owner;
+
+    // Active objects of this type
+    NList<Object> objects;
+
+    // Node on the list of types with active objects
+    NList<SingleType>::Node activeNode;
+
     // The configured life time
     F32 lifeTime;
 
@@ -127,6 +137,10 @@ namespace FX
 
     U32 system : 1;   // TRUE if owned by the FX system; FALSE if local
 
+    // Active objects and the most there have been
+    U32 active;
+    U32 highWater;
+
   public:
 
     // Constructor and Destructor
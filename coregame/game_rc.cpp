@@ -41,6 +41,7 @@
 #include "ai.h"
 #include "fx.h"
 #include "mapobj.h"
+#include "explosionobj.h"
 #include "environment.h"
 #include "message.h"
 #include "demo.h"
@@ -383,16 +384,20 @@ namespace Game
 
       // Inform client
       PERF_S("BuildDisplayList")
+      Vid::Governor::Start( Vid::Governor::stageMESH);
       MapObjCtrl::BuildDisplayList(Team::GetDisplayTeam(), simFrame);
+      Vid::Governor::Stop( Vid::Governor::stageMESH);
       PERF_E("BuildDisplayList")
 
       // Render
       PERF_S("Terrain::Render");
+      Vid::Governor::Start( Vid::Governor::stageTERRAIN);
       Terrain::Sky::Render();
       Client::Display::PreTerrain();
       Terrain::Render();
       Environment::Render();
       Vid::FlushBuckets();
+      Vid::Governor::Stop( Vid::Governor::stageTERRAIN);
       PERF_E("Terrain::Render");
 
       if (Vid::Config::TrilinearOff())
@@ -403,16 +408,22 @@ namespace Game
       }
 
       PERF_S("MapObjCtrl::Render");
+      Vid::Governor::Start( Vid::Governor::stageMESH);
       MapObjCtrl::Render();
       Vid::FlushBuckets();
+      Vid::Governor::Stop( Vid::Governor::stageMESH);
       PERF_E("MapObjCtrl::Render");
 
       PERF_S("Particles::Render");
+      Vid::Governor::Start( Vid::Governor::stagePARTICLE);
       ParticleSystem::Render(Vid::CurCamera());
+      Vid::Governor::Stop( Vid::Governor::stagePARTICLE);
       PERF_E("Particles::Render");
 
       PERF_S("Client::Render");
+      Vid::Governor::Start( Vid::Governor::stageINTERFACE);
       Client::Display::Render();
+      Vid::Governor::Stop( Vid::Governor::stageINTERFACE);
       PERF_E("Client::Render");
     }
 
@@ -841,9 +852,12 @@ namespace Game
               }
             }
 
-            // update auto mrm error factor
+            // steer detail levels toward the target frame time
             //
-            //Mesh::Manager::UpdateMRMFactor();
+            if (display)
+            {
+              Vid::Governor::Update();
+            }
 
             // Pause when a modal control is active
             if (allowModalPause)
@@ -969,9 +983,19 @@ namespace Game
               Movement::Mediator::Process();
               PERF_E("Movement::Mediate");
 
+              // Movement local avoidance, MUST be before object processing
+              PERF_S("Movement::Avoid");
+              Movement::Avoidance::Process();
+              PERF_E("Movement::Avoid");
+
               // Do all per-cycle object processing
               MapObjCtrl::ProcessObjects();
 
+              // Apply damage from this cycle's explosions
+              // MUST be after ProcessObjects
+              //
+              ExplosionObj::ProcessExplosions();
+
               // Perform collision fixups
               //
               // this resets the world matrices
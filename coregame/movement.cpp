@@ -438,6 +438,12 @@ namespace Movement
     // Requires a driver
     newModel->hasDriver = StdLoad::TypeU32(fScope, "HasDriver", TRUE) ? TRUE : FALSE;
 
+    // Local avoidance is on for anything driven on the ground, models can opt out
+    newModel->localAvoidance = StdLoad::TypeU32
+    (
+      fScope, "LocalAvoidance", (newModel->hasDriver && newModel->layers[Claim::LAYER_LOWER].canMove) ? TRUE : FALSE
+    ) ? TRUE : FALSE;
+
     // Setup can ever move flag
     newModel->canEverMove = (newModel->layers[Claim::LAYER_LOWER].canMove || newModel->layers[Claim::LAYER_UPPER].canMove) ? TRUE : FALSE;
 
@@ -81,7 +81,10 @@ namespace Movement
         canEverMove : 1,
 
     // Physically simulated?
-        hasPhysics : 1;
+        hasPhysics : 1,
+
+    // Slow down for units ahead on the lower layer rather than queueing on claims?
+        localAvoidance : 1;
 
 
     // Physics definition
@@ -31,6 +31,7 @@
 #include "sync.h"
 #include "console.h"
 #include "demo.h"
+#include "perfstats.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1069,9 +1070,26 @@ namespace Movement
       PR_MAX
     };
 
+    // Maximum number of items alive at once, must be a power of 2
+    const U32 POOL_SIZE = 1024;
+    const U32 POOL_MASK = POOL_SIZE - 1;
+    const U32 POOL_SHIFT = 10;
+
+    // Hash table slots, kept at twice the pool size so probes stay short
+    const U32 TABLE_SIZE = POOL_SIZE * 2;
+    const U32 TABLE_MASK = TABLE_SIZE - 1;
+    const U16 TABLE_EMPTY = 0xFFFF;
+
+    // Expiry ring buckets, must be a power of 2 and exceed the item lifetime
+    const U32 RING_SIZE = 128;
+    const U32 RING_MASK = RING_SIZE - 1;
+
+    // Cycles an item lives for before it expires
+    const U32 ITEM_LIFETIME = 100;
+
     /////////////////////////////////////////////////////////////////////////////
     //
-    // Struct Key = Master tree key, based on both unit id's
+    // Struct Key - hash key, based on both unit id's
     //
     struct Key
     {
@@ -1109,16 +1127,10 @@ namespace Movement
         return (id1 != rhs.id1 || id2 != rhs.id2);
       }
 
-      // > operator
-      Bool operator>(const Key &rhs)
+      // Home slot in the hash table
+      U32 Hash() const
       {
-        return ((id1 == rhs.id1) ? (id2 > rhs.id2) : (id1 > rhs.id1));
-      }
-
-      // < operator
-      Bool operator<(const Key &rhs)
-      {
-        return ((id1 == rhs.id1) ? (id2 < rhs.id2) : (id1 < rhs.id1));
+        return (((id1 * 0x9E3779B1) ^ (id2 * 0x85EBCA6B)) >> 16) & TABLE_MASK;
       }
     };
 
@@ -1132,6 +1144,9 @@ namespace Movement
       // unit2 is NULL because its an unowned claim
       U16 unownedClaim : 1;
 
+      // Item is allocated from the pool
+      U16 inUse : 1;
+
       // Priority
       S16 priority;
 
@@ -1147,35 +1162,35 @@ namespace Movement
       // Current state
       S32 state;
 
-      // Master tree node
-      NBinTree<Item, Key>::Node treeNode;
+      // Cycle the expiry ring checks this item on, once it is being solved
+      U32 due;
+
+      // Hash key
+      Key key;
 
-      // Priority list node
+      // Priority list node while pending, expiry ring node while solving
       NList<Item>::Node listNode;
 
+      // Node in the list of all live items
+      NList<Item>::Node activeNode;
+
 
       // Constructor
-      Item(UnitObj *unit1, UnitObj *unit2, S16 priority, U32 handle, U32 expire)
-      : priority(priority),
-        handle(handle),
-        expire(expire),
-        state(SS_NONE),
-        unownedClaim(FALSE)
+      Item() : inUse(FALSE)
       {
-        unit[0] = unit1;
-        unit[1] = unit2;
       }
 
-      // Constructor with unowned claim
-      Item(UnitObj *unit1, S16 priority, U32 handle, U32 expire)
-      : priority(priority),
-        handle(handle),
-        expire(expire),
-        state(SS_NONE),
-        unownedClaim(TRUE)
+      // Setup a freshly allocated item, unit2 is NULL for an unowned claim
+      void Setup(const Key &k, UnitObj *unit1, UnitObj *unit2, S16 p, U32 h, U32 e)
       {
+        key = k;
+        priority = p;
+        handle = h;
+        expire = e;
+        state = SS_NONE;
+        unownedClaim = unit2 ? FALSE : TRUE;
         unit[0] = unit1;
-        unit[1] = NULL;
+        unit[1] = unit2;
       }
 
       // Sorted list insertion function
@@ -1186,31 +1201,54 @@ namespace Movement
     };
 
 
-    // Mediation items
-    static NBinTree<Item, Key> items(&Item::treeNode);
+    // Item pool
+    static Item pool[POOL_SIZE];
+
+    // Indices of free pool items
+    static U16 freeIndex[POOL_SIZE];
+    static U32 freeCount;
 
-    // Handle
-    static U32 nextHandle;
+    // Open addressing hash table of pool indices
+    static U16 table[TABLE_SIZE];
+
+    // All live items, in creation order
+    static NList<Item> active(&Item::activeNode);
+
+    // Handle serial
+    static U32 nextSerial;
 
     // Priority lists of pending items
     static NList<Item> priorityList[PR_MAX];
 
-    // List of items mediations in progress
-    static NList<Item> inProgress(&Item::listNode);
+    // Expiry ring of items with mediations in progress, bucketed on their due cycle
+    static NList<Item> expireRing[RING_SIZE];
+
+    // Last cycle the expiry ring was checked for
+    static U32 ringCycle;
 
     // Total cost of solutions this cycle
     static U32 solutionCost;
 
+    // Counters for the cycle in progress
+    static CycleStats stats;
+
+    // Counters for the last complete cycle
+    static CycleStats lastStats;
+
     //
-    // Get a request handle
+    // Get a request handle for the pool item at index
     //
-    static U32 GetMediatorHandle()
+    static U32 GetMediatorHandle(U32 index)
     {
-      if (++nextHandle == InvalidHandle)
+      U32 handle;
+
+      do
       {
-        nextHandle = 0;
+        handle = (++nextSerial << POOL_SHIFT) | index;
       }
-      return (nextHandle);
+      while (handle == InvalidHandle);
+
+      return (handle);
     }
 
 
@@ -1219,12 +1257,32 @@ namespace Movement
     //
     static void Init()
     {
-      nextHandle = 0;
+      U32 i;
+
+      nextSerial = 0;
+      ringCycle = 0;
 
-      for (U32 i = 0; i < PR_MAX; i++)
+      Utils::Memset(&stats, 0, sizeof (stats));
+      Utils::Memset(&lastStats, 0, sizeof (lastStats));
+
+      for (i = 0; i < PR_MAX; i++)
       {
         priorityList[i].SetNodeMember(&Item::listNode);
       }
+      for (i = 0; i < RING_SIZE; i++)
+      {
+        expireRing[i].SetNodeMember(&Item::listNode);
+      }
+      for (i = 0; i < TABLE_SIZE; i++)
+      {
+        table[i] = TABLE_EMPTY;
+      }
+
+      // Hand out low indices first
+      for (freeCount = 0; freeCount < POOL_SIZE; freeCount++)
+      {
+        freeIndex[freeCount] = U16(POOL_SIZE - 1 - freeCount);
+      }
     }
 
 
@@ -1233,15 +1291,128 @@ namespace Movement
     //
     static void Done()
     {
+      U32 i;
+
       // Clear lists
-      for (U32 i = 0; i < PR_MAX; i++)
+      for (i = 0; i < PR_MAX; i++)
       {
         priorityList[i].UnlinkAll();
       }
-      inProgress.UnlinkAll();
+      for (i = 0; i < RING_SIZE; i++)
+      {
+        expireRing[i].UnlinkAll();
+      }
+      active.UnlinkAll();
+
+      // Release references held by the pool
+      for (i = 0; i < POOL_SIZE; i++)
+      {
+        pool[i].unit[0] = NULL;
+        pool[i].unit[1] = NULL;
+        pool[i].inUse = FALSE;
+      }
+    }
+
+
+    //
+    // Find the item for a key
+    //
+    static Item *Find(const Key &key)
+    {
+      for (U32 slot = key.Hash(); table[slot] != TABLE_EMPTY; slot = (slot + 1) & TABLE_MASK)
+      {
+        Item *item = &pool[table[slot]];
+
+        if (item->key == key)
+        {
+          return (item);
+        }
+      }
+      return (NULL);
+    }
+
+
+    //
+    // Allocate an item from the pool and hash it, returns NULL if the pool is full
+    //
+    static Item *Create(const Key &key, UnitObj *unit1, UnitObj *unit2, S16 priority)
+    {
+      if (!freeCount)
+      {
+        stats.dropped++;
+        return (NULL);
+      }
+
+      U32 index = freeIndex[--freeCount];
+      Item *item = &pool[index];
+
+      ASSERT(!item->inUse)
+
+      item->Setup(key, unit1, unit2, priority, GetMediatorHandle(index), GameTime::SimCycle() + ITEM_LIFETIME);
+      item->inUse = TRUE;
+
+      // The table is never more than half full so there is always an empty slot
+      U32 slot = key.Hash();
+
+      while (table[slot] != TABLE_EMPTY)
+      {
+        slot = (slot + 1) & TABLE_MASK;
+      }
+      table[slot] = U16(index);
+
+      active.Append(item);
+      stats.created++;
+
+      return (item);
+    }
+
+
+    //
+    // Unhash an item and return it to the pool
+    //
+    static void Release(Item *item)
+    {
+      ASSERT(item->inUse)
+
+      U32 index = U32(item - pool);
+      U32 slot = item->key.Hash();
+
+      while (table[slot] != index)
+      {
+        ASSERT(table[slot] != TABLE_EMPTY)
+        slot = (slot + 1) & TABLE_MASK;
+      }
+
+      // Shift back any following entries that probed past this slot
+      U32 next = slot;
+
+      for (;;)
+      {
+        next = (next + 1) & TABLE_MASK;
+
+        if (table[next] == TABLE_EMPTY)
+        {
+          break;
+        }
+
+        U32 home = pool[table[next]].key.Hash();
+
+        // Can the entry at 'next' legally live in 'slot'
+        if (((next - home) & TABLE_MASK) >= ((next - slot) & TABLE_MASK))
+        {
+          table[slot] = table[next];
+          slot = next;
+        }
+      }
+      table[slot] = TABLE_EMPTY;
 
-      // Only delete memory from master tree
-      items.DisposeAll();
+      active.Unlink(item);
+
+      item->unit[0] = NULL;
+      item->unit[1] = NULL;
+      item->inUse = FALSE;
+
+      freeIndex[freeCount++] = U16(index);
     }
 
 
@@ -1286,18 +1457,15 @@ namespace Movement
 
       Key key(unit1->Id(), unit2->Id());
 
-      if (Item *item = items.Find(key))
+      if (Item *item = Find(key))
       {
         // Item already exists, update it with new information
         Reprioritize(item, priority);
       }
       else
-      {
-        Item *newItem = new Item(unit1, unit2, priority, GetMediatorHandle(), GameTime::SimCycle() + 100);
-
-        // Add item to tree
-        items.Add(key, newItem);
 
+      if (Item *newItem = Create(key, unit1, unit2, priority))
+      {
         // Add item to priority list
         GetPriorityList(priority)->Insert(newItem);
 
@@ -1313,17 +1481,14 @@ namespace Movement
     {
       Key key(unit1->Id());
 
-      if (Item *item = items.Find(key))
+      if (Item *item = Find(key))
       {
         Reprioritize(item, priority);
       }
       else
-      {
-        Item *newItem = new Item(unit1, priority, GetMediatorHandle(), GameTime::SimCycle() + 100);
-
-        // Add item to tree
-        items.Add(key, newItem);
 
+      if (Item *newItem = Create(key, unit1, NULL, priority))
+      {
         // Add item to priority list
         GetPriorityList(priority)->Insert(newItem);
 
@@ -1375,9 +1540,11 @@ namespace Movement
       // Ensure state is updated so it wont reprioritize
       item->state = SS_SOLVING;
 
-      // Slap it on the in-progress list
+      // Slap it on the expiry ring, never on a cycle that has already been checked
+      item->due = Max<U32>(item->expire, ringCycle + 1);
+
       list.Unlink(item);
-      inProgress.Append(item);
+      expireRing[item->due & RING_MASK].Append(item);
 
       // Setup both drivers
       //item->unit[0]->GetDriver()->GetCoordinator().Setup(item);
@@ -1393,7 +1560,7 @@ namespace Movement
       // Determine the list that this item is one
       if (item->state == SS_SOLVING)
       {
-        return (&inProgress);
+        return (&expireRing[item->due & RING_MASK]);
       }
       else
       {
@@ -1412,8 +1579,8 @@ namespace Movement
       // Remove from priority list
       list->Unlink(item);
 
-      // Delete from system
-      items.Dispose(item);
+      // Return to the pool
+      Release(item);
     }
 
 
@@ -1438,6 +1605,7 @@ namespace Movement
         case SS_DONE:
         {
           // Resolution was successful
+          stats.resolved++;
 
           break;
         }
@@ -1464,14 +1632,12 @@ namespace Movement
     //
     void Complete(U32 handle, U32 result)
     {
-      // Search tree for this handle
-      for (NList<Item>::Iterator i(&inProgress); *i; i++)
+      // The handle carries the pool index
+      Item *item = &pool[handle & POOL_MASK];
+
+      if (item->inUse && item->handle == handle && item->state == SS_SOLVING)
       {
-        if ((*i)->handle == handle)
-        {
-          Complete(*i, inProgress, result);
-          break;
-        }
+        Complete(item, *GetItemsList(item), result);
       }
     }
 
@@ -1483,12 +1649,12 @@ namespace Movement
     {
       ASSERT(id != 0)
 
-      NBinTree<Item, Key>::Iterator i(&items);
+      NList<Item>::Iterator i(&active);
+      Item *item;
 
-      while (*i)
+      while ((item = i++) != NULL)
       {
-        Key key = i.GetKey();
-        Item *item = i++;
+        const Key &key = item->key;
 
         if (key.id1 == id || key.id2 == id)
         {
@@ -1513,19 +1679,16 @@ namespace Movement
     {
       ASSERT(id != 0)
 
-      NBinTree<Item, Key>::Iterator i(&items);
-
-      while (*i)
+      for (NList<Item>::Iterator i(&active); *i; i++)
       {
-        const Key &key = i.GetKey();
         Item *item = *i;
+        const Key &key = item->key;
 
         if ((key.id1 == id || key.id2 == id) && (item->state == SS_NONE))
         {
           LOG_MOVE2(("M%6d ExpireForUnit:%d", item->handle, id))
           item->expire = GameTime::SimCycle();
         }
-        i++;
       }
     }
 
@@ -1645,54 +1808,51 @@ namespace Movement
 
 
     //
-    // Process
+    // Time out in progress items that are due
     //
-    void Process()
+    static void ProcessExpiry(U32 now)
     {
-      const U32 Requester     = 0;
-      const U32 NonRequester  = 1;
+      // Only the last RING_SIZE cycles can have anything due
+      U32 cycle = now;
 
-#ifdef DEVELOPMENT
+      if (ringCycle < now)
       {
-        static U32 prevCount;
-        static U32 peak;
-
-        peak = Max(items.GetCount(), peak);
-
-        if (items.GetCount() != prevCount)
-        {
-          prevCount = items.GetCount();
-          MSWRITEV(13, (0, 40, "Mediator: %4d items %4d max", prevCount, peak));
-        }
+        cycle = Max<U32>(ringCycle + 1, now >= RING_MASK ? now - RING_MASK : 0);
       }
-#endif
 
-      // Check all in progress items for any completions
+      for (; cycle <= now; cycle++)
       {
-        NList<Item>::Iterator i(&inProgress);
+        NList<Item> &list = expireRing[cycle & RING_MASK];
+        NList<Item>::Iterator i(&list);
         Item *item;
 
         while ((item = i++) != NULL)
         {
-          if (item->state == SS_DONE)
+          if (item->due <= now)
           {
-            Complete(item, inProgress, SS_DONE);
-          }
-          else
+            LOG_MOVE2(("M%6d timed out cycle:%d", item->handle, now))
 
-          if (GameTime::SimCycle() >= item->expire)
-          {
-            LOG_MOVE2(("M%6d timed out cycle:%d", item->handle, GameTime::SimCycle()))
-            Complete(item, inProgress, SS_ABORTED);
+            stats.expired++;
+            Complete(item, list, SS_ABORTED);
           }
         }
       }
 
+      ringCycle = now;
+    }
+
+
+    //
+    // Process pending items
+    //
+    static void ProcessPending(U32 now)
+    {
+      const U32 Requester     = 0;
+      const U32 NonRequester  = 1;
+
       // Process all high priority items, then move to lower items if there is time
       solutionCost = 0;
 
-      U32 now = GameTime::SimCycle();
-
       for (S32 current = 0; current < PR_MAX; current++)
       {
         NList<Item> &list = *GetPriorityList(current);
@@ -1736,6 +1896,7 @@ namespace Movement
                 LOG_MOVE2(("M%6d expired", item->handle))
 
                 // This one has expired, delete it
+                stats.expired++;
                 Complete(item, list, SS_ABORTED);
                 continue;
               }
@@ -2021,6 +2182,270 @@ namespace Movement
         }
       }
     }
+
+
+    //
+    // Process
+    //
+    void Process()
+    {
+      U32 start = Clock::Time::UsLwr();
+      U32 now = GameTime::SimCycle();
+
+      // Items are created after Process during the rest of the cycle, so
+      // keep the whole of the last cycle before starting the next one
+      lastStats = stats;
+      Utils::Memset(&stats, 0, sizeof (stats));
+
+      // Check all in progress items for any completions
+      ProcessExpiry(now);
+
+      // Try to resolve the pending items
+      ProcessPending(now);
+
+      stats.time = Clock::Time::UsLwr() - start;
+
+      PERF_COUNT("Mediator items", active.GetCount(), POOL_SIZE)
+      PERF_COUNT("Mediator created", lastStats.created, 0)
+      PERF_COUNT("Mediator dropped", lastStats.dropped, 0)
+
+#ifdef DEVELOPMENT
+      {
+        static U32 peak;
+
+        peak = Max(active.GetCount(), peak);
+
+        MSWRITEV(13, (0, 40, "Mediator: %4d items %4d max", active.GetCount(), peak));
+        MSWRITEV(13, (1, 40, "+%3d ok %3d exp %3d drop %3d %5dus", lastStats.created, lastStats.resolved, lastStats.expired, lastStats.dropped, lastStats.time));
+      }
+#endif
+    }
+
+
+    //
+    // GetLastStats
+    //
+    const CycleStats & GetLastStats()
+    {
+      return (lastStats);
+    }
+  }
+
+
+  ///////////////////////////////////////////////////////////////////////////////
+  //
+  // Local avoidance
+  //
+  // A one dimensional velocity obstacle along each unit's current segment.
+  // Units stay on their claimed grains, so the only freedom is speed: a unit
+  // following another is limited to the speed that keeps it from closing the
+  // gap within the time horizon.  Oncoming and stationary units are left to
+  // the claim system and the mediator, which handle the real deadlocks.
+  //
+  // Every limit is computed from the positions at the start of the cycle and
+  // only the minimum over neighbours is kept, so the result does not depend
+  // on the order units are visited in.
+  //
+  namespace Avoidance
+  {
+    // Size of the neighbour buckets in metres
+    const F32 BUCKET_SIZE = 16.0F;
+    const F32 BUCKET_SIZE_INV = 1.0F / BUCKET_SIZE;
+
+    // Number of hash chains, must be a power of 2
+    const U32 CHAIN_COUNT = 256;
+    const U32 CHAIN_MASK = CHAIN_COUNT - 1;
+
+    // Time horizon to close the gap over (s)
+    const F32 HORIZON = 1.0F;
+
+    // Neighbour must be heading within this cosine of our heading to be followed
+    const F32 FOLLOW_COS = COS_45;
+
+    // End of a chain
+    const U32 CHAIN_END = U32_MAX;
+
+    //
+    // Struct Record - gathered kinematic state of one unit
+    //
+    struct Record
+    {
+      // Driver
+      Driver *driver;
+
+      // Position and unit heading in the horizontal plane
+      Point<F32> pos;
+      Point<F32> dir;
+
+      // Current speed
+      F32 speed;
+
+      // Radius in the horizontal plane
+      F32 radius;
+
+      // Bucket coordinates
+      S32 bx, bz;
+
+      // Next record in the same chain
+      U32 next;
+    };
+
+    // Gathered records
+    static Array<Record> records;
+
+    // First record in each chain
+    static U32 chains[CHAIN_COUNT];
+
+
+    //
+    // Chain for a bucket
+    //
+    static U32 ChainIndex(S32 bx, S32 bz)
+    {
+      return (((U32(bx) * 73856093) ^ (U32(bz) * 19349663)) & CHAIN_MASK);
+    }
+
+
+    //
+    // Speed limit for 'r' from the records in one bucket
+    //
+    static F32 LimitFromBucket(const Record &r, S32 bx, S32 bz, F32 limit)
+    {
+      for (U32 j = chains[ChainIndex(bx, bz)]; j != CHAIN_END; j = records.data[j].next)
+      {
+        const Record &o = records.data[j];
+
+        if (&o == &r || o.bx != bx || o.bz != bz)
+        {
+          continue;
+        }
+
+        // Only units ahead of us
+        Point<F32> rel = o.pos - r.pos;
+        F32 along = rel.x * r.dir.x + rel.z * r.dir.z;
+
+        if (along <= 0.0F)
+        {
+          continue;
+        }
+
+        // Only units in our lane
+        F32 combined = r.radius + o.radius;
+        F32 lateral = F32(fabs(rel.x * r.dir.z - rel.z * r.dir.x));
+
+        if (lateral >= combined)
+        {
+          continue;
+        }
+
+        // Only units going our way, anything else is for the mediator
+        F32 cosine = o.dir.x * r.dir.x + o.dir.z * r.dir.z;
+
+        if (cosine < FOLLOW_COS || o.speed <= 0.0F)
+        {
+          continue;
+        }
+
+        // Close the gap no faster than the horizon allows
+        F32 gap = Max<F32>(along - combined, 0.0F);
+
+        limit = Min<F32>(limit, o.speed * cosine + gap * (1.0F / HORIZON));
+      }
+      return (limit);
+    }
+
+
+    //
+    // Done
+    //
+    void Done()
+    {
+      records.Release();
+    }
+
+
+    //
+    // Process
+    //
+    void Process()
+    {
+      U32 count = 0;
+      U32 i;
+
+      if (records.count < Driver::avoidList.GetCount())
+      {
+        records.Alloc(Driver::avoidList.GetCount() + 64);
+      }
+
+      for (i = 0; i < CHAIN_COUNT; i++)
+      {
+        chains[i] = CHAIN_END;
+      }
+
+      // Gather the units following a linear segment on the ground
+      for (NList<Driver>::Iterator d(&Driver::avoidList); *d; d++)
+      {
+        Driver *driver = *d;
+
+        driver->avoidSpeed = F32_MAX;
+
+        if 
+        (
+          driver->tail 
+          && 
+          driver->state.Test(0xDCED7E12) // "Driving"
+          && 
+          driver->moveState.Test(0x9E947215) // "Moving"
+          &&
+          IsLinear[driver->segments[0].accelType]
+          &&
+          driver->GetCurrentLayer() == Claim::LAYER_LOWER
+        )
+        {
+          const Matrix &m = driver->unitObj->WorldMatrix();
+          Record &r = records.data[count];
+
+          r.dir.Set(m.front.x, m.front.z);
+
+          F32 mag2 = r.dir.x * r.dir.x + r.dir.z * r.dir.z;
+
+          if (mag2 < 1e-4F)
+          {
+            continue;
+          }
+          r.dir *= 1.0F / F32(sqrt(mag2));
+
+          r.driver = driver;
+          r.pos.Set(m.posit.x, m.posit.z);
+          r.speed = driver->unitObj->GetSpeed();
+          r.radius = F32(driver->grainSize) * HALF_GRAIN;
+          r.bx = Utils::FtoL(r.pos.x * BUCKET_SIZE_INV);
+          r.bz = Utils::FtoL(r.pos.z * BUCKET_SIZE_INV);
+
+          U32 chain = ChainIndex(r.bx, r.bz);
+
+          r.next = chains[chain];
+          chains[chain] = count++;
+        }
+      }
+
+      // Limit each unit by the neighbours in the surrounding buckets
+      for (i = 0; i < count; i++)
+      {
+        Record &r = records.data[i];
+        F32 limit = F32_MAX;
+
+        for (S32 z = r.bz - 1; z <= r.bz + 1; z++)
+        {
+          for (S32 x = r.bx - 1; x <= r.bx + 1; x++)
+          {
+            limit = LimitFromBucket(r, x, z, limit);
+          }
+        }
+
+        r.driver->avoidSpeed = limit;
+      }
+    }
   }
 
 
@@ -3071,6 +3496,7 @@ namespace Movement
   Driver::HookProc Driver::removeFromMapHookProc = NULL;
 
   U32 Driver::nextId;
+  NList<Driver> Driver::avoidList(&Driver::avoidNode);
 
 
   //
@@ -3095,7 +3521,8 @@ namespace Movement
     passUnit(FALSE),
     omega(0.0F),
     probeCount(0),
-    prevDirectTurn(F32_MAX)
+    prevDirectTurn(F32_MAX),
+    avoidSpeed(F32_MAX)
   {
     ASSERT(unitObj)
     current.valid = pending.valid = FALSE;
@@ -3113,6 +3540,10 @@ namespace Movement
   //
   Driver::~Driver()
   {
+    if (avoidNode.InUse())
+    {
+      avoidList.Unlink(this);
+    }
     pointList.DisposeAll();
   }
 
@@ -3181,6 +3612,12 @@ namespace Movement
     {
       AddToMapHelper();
     }
+
+    // Register for local avoidance
+    if (model.localAvoidance && !avoidNode.InUse())
+    {
+      avoidList.Append(this);
+    }
   }
 
 
@@ -3197,6 +3634,13 @@ namespace Movement
     // Clear mediator items
     Mediator::PurgeForUnit(unitObj->Id());
 
+    // Leave local avoidance
+    if (avoidNode.InUse())
+    {
+      avoidList.Unlink(this);
+    }
+    avoidSpeed = F32_MAX;
+
     // Reset just about everything
     HardReset();
   }
@@ -6757,6 +7201,9 @@ ExitLoop:
 #endif
       requiredSpeed *= Max<F32>(unitObj->GetBalanceData().speed, 0.05F);
     }
+
+    // Don't close on the unit ahead faster than local avoidance allows
+    requiredSpeed = Min<F32>(requiredSpeed, avoidSpeed);
     //ASSERT(requiredSpeed > 0.0F)
 
     S32 terrainInfluence = 0;
@@ -8699,6 +9146,12 @@ ExitLoop:
     // Shutdown mediator
     Mediator::Done();
 
+    // Release the avoidance records
+    Avoidance::Done();
+
+    // Nothing should be left, but the list must be empty when destroyed
+    avoidList.UnlinkAll();
+
     // Cleanup state machines
     stateMachine.CleanUp();
     moveStateMachine.CleanUp();
@@ -59,11 +59,49 @@ namespace Movement
 
     struct Item;
 
+    //
+    // Struct CycleStats - per cycle counters
+    //
+    struct CycleStats
+    {
+      // Items created
+      U32 created;
+
+      // Items resolved successfully
+      U32 resolved;
+
+      // Items that ran out of time
+      U32 expired;
+
+      // Items not created because the pool was full
+      U32 dropped;
+
+      // Time spent in Process (us)
+      U32 time;
+    };
+
     // Process each cycle
     void Process();
 
     // Notify that an item is complete
     void Complete(U32 handle, U32 result);
+
+    // Counters for the last complete cycle
+    const CycleStats & GetLastStats();
+  };
+
+
+  ///////////////////////////////////////////////////////////////////////////////
+  //
+  // Avoidance - speed limits for units following other units
+  //
+  namespace Avoidance
+  {
+    // Process each cycle, before the drivers
+    void Process();
+
+    // Shutdown
+    void Done();
   };
 
 
@@ -595,12 +633,28 @@ namespace Movement
     // Last successful DirectTurn angle
     F32 prevDirectTurn;
 
+    //
+    // Data for local avoidance
+    //
+
+    // Speed limit from local avoidance, F32_MAX when unconstrained
+    F32 avoidSpeed;
+
+    // Node in the local avoidance list
+    NList<Driver>::Node avoidNode;
+
+
+    // Drivers taking part in local avoidance
+    static NList<Driver> avoidList;
 
     // Map hook pointers
     typedef void (Driver::*HookProc)();
     static HookProc addToMapHookProc;
     static HookProc removeFromMapHookProc;
 
+    // Local avoidance needs the segment and state data
+    friend void Avoidance::Process();
+
   protected:
 
     // Common movement functionality
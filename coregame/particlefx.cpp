@@ -335,7 +335,7 @@ namespace ParticleFX
       {
         // a few less particles
         //
-        F32 df  = (1.0f - *Vid::Var::perfs[2]);
+        F32 df  = (1.0f - Vid::renderState.perfs[2]);
         F32 dfp = df * type->particleClass->priority;
         if (dfp >= .75f)    // .75 = (perf = .25) for a priority 1 particle
         {
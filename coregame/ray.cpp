@@ -176,20 +176,50 @@ namespace Ray
 
 
   //
-  // Test collision of ray with one cell
+  // Struct CellCache - Cell heights shared between the rays of a batch
   //
-  static Bool CellTest(Point<S32> cell, const Vector &pos, const Vector &dir, F32 &dist, Vector &hitPos, F32 margin, Bool testWater)
+  struct CellCache
   {
-    Vector n;
-    F32 dirN;
-    F32 h[4];
+    enum { SIZE = 64 };
 
-    if (!WorldCtrl::CellOnMap(cell.x, cell.z))
+    struct Item
     {
-      LOG_ERR(("SUBMIT THIS LOG!!!! CellTest: Cell not on map %d,%d", cell.x, cell.z))
+      S32 x, z;
+      F32 h[4];
+    };
+
+    Item items[SIZE];
+
+    CellCache()
+    {
+      for (U32 i = 0; i < SIZE; i++)
+      {
+        items[i].x = -1;
+      }
+    }
+
+    // Get the item for the given cell, TRUE if it is already filled in
+    Bool Find(Point<S32> cell, Item * &item)
+    {
+      item = &items[(cell.x * 31 + cell.z) & (SIZE - 1)];
+
+      if (item->x == cell.x && item->z == cell.z)
+      {
+        return (TRUE);
+      }
+
+      item->x = cell.x;
+      item->z = cell.z;
       return (FALSE);
     }
+  };
+
 
+  //
+  // Get the heights of one cell
+  //
+  static void CellHeights(Point<S32> cell, F32 *h, Bool testWater)
+  {
     TerrainData::CellHeights(cell.x, cell.z, h);
 
     // Check for water
@@ -205,6 +235,42 @@ namespace Ray
         if (h[3] < waterHeight) h[3] = waterHeight;
       }
     }
+  }
+
+
+  //
+  // Test collision of ray with one cell
+  //
+  static Bool CellTest(Point<S32> cell, const Vector &pos, const Vector &dir, F32 &dist, Vector &hitPos, F32 margin, Bool testWater, CellCache *cache)
+  {
+    Vector n;
+    F32 dirN;
+    F32 h[4];
+
+    if (!WorldCtrl::CellOnMap(cell.x, cell.z))
+    {
+      LOG_ERR(("SUBMIT THIS LOG!!!! CellTest: Cell not on map %d,%d", cell.x, cell.z))
+      return (FALSE);
+    }
+
+    if (cache)
+    {
+      CellCache::Item *item;
+
+      if (!cache->Find(cell, item))
+      {
+        CellHeights(cell, item->h, testWater);
+      }
+
+      h[0] = item->h[0];
+      h[1] = item->h[1];
+      h[2] = item->h[2];
+      h[3] = item->h[3];
+    }
+    else
+    {
+      CellHeights(cell, h, testWater);
+    }
 
     // Add in margin of error
     h[0] += margin;
@@ -313,34 +379,28 @@ namespace Ray
 
 
   //
-  // Test for collision with terrain
+  // Walk the cells crossed by the span 'start' to 'end' of the ray 'pos', 'dir'
   //
-  Bool TerrainTest(Vector pos, Vector end, Vector dir, F32 &dist, Vector &hitPos, F32 margin, Bool testWater)
+  // All vectors are in cell units
+  //
+  static Bool MarchCells(const Vector &pos, const Vector &start, const Vector &end, const Vector &dir, F32 &dist, Vector &hitPos, F32 margin, Bool testWater, CellCache *cache)
   {
-    ASSERT(WorldCtrl::MetreOnMap(pos.x, pos.z))
-    ASSERT(WorldCtrl::MetreOnMap(end.x, end.z))
-
     Point<S32> c0, c1, s;
     Point<F32> d, f;
 
-    // Scale metre locations into floating point cell positions
-    dir *= WC_CELLSIZEF32INV;
-    pos *= WC_CELLSIZEF32INV;
-    end *= WC_CELLSIZEF32INV;
-
     // Start and end cells
     U16 cw = Utils::FP::SetTruncMode();
 
-    c0.x = Utils::FastFtoLProc(pos.x);
-    c0.z = Utils::FastFtoLProc(pos.z);
+    c0.x = Utils::FastFtoLProc(start.x);
+    c0.z = Utils::FastFtoLProc(start.z);
     c1.x = Utils::FastFtoLProc(end.x);
     c1.z = Utils::FastFtoLProc(end.z);
 
     Utils::FP::RestoreModeProc(cw);
 
     // Fractional offset
-    f.x = pos.x - 0.5f - c0.x;
-    f.z = pos.z - 0.5f - c0.z;
+    f.x = start.x - 0.5f - c0.x;
+    f.z = start.z - 0.5f - c0.z;
 
     // Increment
     s.x = 1;
@@ -379,7 +439,7 @@ namespace Ray
       while (c1.x-- >= 0)
       {
         // test for intersection
-        if (CellTest(c0, pos, dir, dist, hitPos, margin, testWater))
+        if (CellTest(c0, pos, dir, dist, hitPos, margin, testWater, cache))
         {
           return (TRUE);
         }
@@ -394,7 +454,7 @@ namespace Ray
           dv -= d.x;
 
           // test for intersection in new square
-          if (CellTest(c0, pos, dir, dist, hitPos, margin, testWater))
+          if (CellTest(c0, pos, dir, dist, hitPos, margin, testWater, cache))
           {
             return (TRUE);
           }
@@ -414,7 +474,7 @@ namespace Ray
 
       while (c1.z-- >= 0)
       {
-        if (CellTest(c0, pos, dir, dist, hitPos, margin, testWater))
+        if (CellTest(c0, pos, dir, dist, hitPos, margin, testWater, cache))
         {
           return (TRUE);
         }
@@ -429,7 +489,7 @@ namespace Ray
           dv -= d.z;
 
           // test for intersection in new square
-          if (CellTest(c0, pos, dir, dist, hitPos, margin, testWater))
+          if (CellTest(c0, pos, dir, dist, hitPos, margin, testWater, cache))
           {
             return (TRUE);
           }
@@ -447,6 +507,63 @@ namespace Ray
   }
 
 
+  //
+  // Recursively split the span 'start' to 'end' of the ray, dropping any part
+  // that passes above the height pyramid, and march the cells of what remains
+  //
+  static Bool SpanTest(const Vector &pos, const Vector &start, const Vector &end, const Vector &dir, U32 depth, F32 &dist, Vector &hitPos, F32 margin, Bool testWater, CellCache *cache = NULL)
+  {
+    // Spans no wider than this many cells are marched directly
+    const S32 SPAN_CELLS = 4;
+
+    // Maximum recursion depth
+    const U32 SPAN_DEPTH = 16;
+
+    // Cells covered by this span
+    S32 x0 = S32(Min<F32>(start.x, end.x));
+    S32 z0 = S32(Min<F32>(start.z, end.z));
+    S32 x1 = S32(Max<F32>(start.x, end.x));
+    S32 z1 = S32(Max<F32>(start.z, end.z));
+
+    // Nothing beneath the span can reach it
+    if (Min<F32>(start.y, end.y) * WC_CELLSIZEF32 > Terrain::Pyramid::MaxHeight(x0, z0, x1, z1) + margin)
+    {
+      return (FALSE);
+    }
+
+    if (depth >= SPAN_DEPTH || (x1 - x0 <= SPAN_CELLS && z1 - z0 <= SPAN_CELLS))
+    {
+      return (MarchCells(pos, start, end, dir, dist, hitPos, margin, testWater, cache));
+    }
+
+    // Test the near half first so the closest hit wins
+    Vector mid = (start + end) * 0.5F;
+
+    return
+    (
+      SpanTest(pos, start, mid, dir, depth + 1, dist, hitPos, margin, testWater, cache) ||
+      SpanTest(pos, mid, end, dir, depth + 1, dist, hitPos, margin, testWater, cache)
+    );
+  }
+
+
+  //
+  // Test for collision with terrain
+  //
+  Bool TerrainTest(Vector pos, Vector end, Vector dir, F32 &dist, Vector &hitPos, F32 margin, Bool testWater)
+  {
+    ASSERT(WorldCtrl::MetreOnMap(pos.x, pos.z))
+    ASSERT(WorldCtrl::MetreOnMap(end.x, end.z))
+
+    // Scale metre locations into floating point cell positions
+    dir *= WC_CELLSIZEF32INV;
+    pos *= WC_CELLSIZEF32INV;
+    end *= WC_CELLSIZEF32INV;
+
+    return (SpanTest(pos, pos, end, dir, 0, dist, hitPos, margin, testWater));
+  }
+
+
   //
   // Test for a collision with ground along a given ray
   //
@@ -472,4 +589,56 @@ namespace Ray
     return (FALSE);
   }
 
+
+  //
+  // Test a batch of rays from one origin for collisions with the ground
+  //
+  // Rays from the same origin cross the same cells near it, so the cell
+  // heights are fetched once for the whole batch
+  //
+  U32 TerrainTestBatch(const Vector &start, const Vector *ends, U32 count, F32 tolerance, F32 margin, Bool testWater, U32 *clear)
+  {
+    ASSERT(WorldCtrl::MetreOnMap(start.x, start.z))
+
+    CellCache cache;
+    U32 clearCount = 0;
+
+    Utils::Memset(clear, 0, ((count + 31) >> 5) * sizeof(U32));
+
+    // Scale metre locations into floating point cell positions
+    Vector pos = start * WC_CELLSIZEF32INV;
+
+    for (U32 i = 0; i < count; i++)
+    {
+      ASSERT(WorldCtrl::MetreOnMap(ends[i].x, ends[i].z))
+
+      Vector hitPos;
+      Vector dir = ends[i] - start;
+      F32 dist = dir.Magnitude();
+      Bool blocked = FALSE;
+
+      if (dist > 0.0F)
+      {
+        F32 newDist = dist;
+
+        dir *= WC_CELLSIZEF32INV / dist;
+
+        // Allow a small tolerance in case the end point of the ray was on the terrain
+        blocked =
+        (
+          SpanTest(pos, pos, ends[i] * WC_CELLSIZEF32INV, dir, 0, newDist, hitPos, margin, testWater, &cache) &&
+          newDist + tolerance < dist
+        );
+      }
+
+      if (!blocked)
+      {
+        clear[i >> 5] |= 1 << (i & 31);
+        clearCount++;
+      }
+    }
+
+    return (clearCount);
+  }
+
 }
@@ -42,6 +42,10 @@ namespace Ray
 
   // Test for collision with terrain
   Bool TerrainTest(Vector pos, Vector end, Vector dir, F32 &dist, Vector &hitPos, F32 margin, Bool testWater);
+
+  // Test a batch of rays from one origin, sets bit i of 'clear' if ray i reaches its end
+  // 'clear' must hold (count + 31) / 32 words, returns the number of clear rays
+  U32 TerrainTestBatch(const Vector &start, const Vector *ends, U32 count, F32 tolerance, F32 margin, Bool testWater, U32 *clear);
 }
 
 #endif
\ No newline at end of file
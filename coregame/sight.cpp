@@ -93,6 +93,9 @@ namespace Sight
   // Sight map
   static U16 **seeMap[Map::LV_MAX][Game::MAX_TEAMS];
 
+  // Bumped whenever a team sees a new ground cell
+  static U32 seenSerial[Game::MAX_TEAMS];
+
   DEBUG_STATIC_GUARD_BLOCK;
 
   // Clusters that sight has changed within
@@ -360,6 +363,12 @@ namespace Sight
     // Done 
     bFile.CloseBlock();
 
+    // Seen flags were added
+    for (U32 t = 0; t < Game::MAX_TEAMS; t++)
+    {
+      seenSerial[t]++;
+    }
+
     // Ensure display gets updated for new data
     DirtyAllCells();
   }
@@ -462,6 +471,10 @@ namespace Sight
         (*seeingMapEntry)++;
 
         // Set bit in seen map
+        if (level == Map::LV_LO && !(*seeingMapEntry & SEENMASK))
+        {
+          seenSerial[team]++;
+        }
         (*seeingMapEntry) |= SEENMASK;
       }
     }
@@ -1005,6 +1018,9 @@ namespace Sight
       invTeamRemap[t]   = Game::MAX_TEAMS;
       teamDirtyClust[t] = NULL;
       teamLastRescan[t] = U32_MAX;
+
+      // Seen flags are about to be reset
+      seenSerial[t]++;
     }
 
     if (editMode)
@@ -1462,6 +1478,19 @@ namespace Sight
   }
 
 
+  //
+  // Changes whenever team sees a cell it had never seen before
+  //
+  U32 SeenSerial(Team *team)
+  {
+    ASSERT(team)
+    ASSERT(sysInit)
+    ASSERT(teamRemap[team->GetId()] < teamCount)
+
+    return (seenSerial[teamRemap[team->GetId()]]);
+  }
+
+
   //
   // TRUE iff top left corner of cell x,z has been seen by team
   //
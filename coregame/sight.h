@@ -71,6 +71,9 @@ namespace Sight
   // Return the eye position of an object
   F32 EyePosition(UnitObj *u);
 
+  // Changes whenever team sees a cell it had never seen before
+  U32 SeenSerial(Team *team);
+
   // TRUE iff top left corner of cell (x,y) has been seen by team
   Bool Seen(U32 x, U32 z, Team *team);
 
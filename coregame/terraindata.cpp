@@ -607,6 +607,9 @@ namespace TerrainData
     bitArraySession = new BitArray2d(WorldCtrl::CellMapX(), WorldCtrl::CellMapZ());
     bitArrayBlockLOS = new BitArray2d(WorldCtrl::CellMapX(), WorldCtrl::CellMapZ());
 
+    // Ray casts need the height pyramid to include footprinted layers
+    Terrain::Pyramid::SetCellHeightsProc(CellHeights);
+
     // System now initialized
     initialized = TRUE;
   }
@@ -621,6 +624,9 @@ namespace TerrainData
   {
     ASSERT(initialized);
 
+    // Stop the height pyramid from looking at the layer bits
+    Terrain::Pyramid::SetCellHeightsProc(NULL);
+
     // Dispose of dynamic data
     delete [] cellMap;
     delete bitArrayPaint;
@@ -1229,7 +1235,7 @@ namespace TerrainData
       }   
 
       // Do we need to notify terrain system of change
-      if (sessionHeight)
+      if (sessionHeight || sessionLayer)
       {
         // Increase both dimensions by one to cater for edge of map
         max.x++;
@@ -1239,8 +1245,16 @@ namespace TerrainData
         Area<S32> rect( min, max);
         rect.Sort();
 
-        // Recalculate terrain data
-        Terrain::CalcCellRect( rect);
+        if (sessionHeight)
+        {
+          // Recalculate terrain data
+          Terrain::CalcCellRect( rect);
+        }
+        else
+        {
+          // Footprinted layers only affect the height pyramid
+          Terrain::Pyramid::Update( rect);
+        }
       }
 
       // Dispose of all points
@@ -481,6 +481,9 @@ namespace Weapon
     // Offer a new target to the weapon
     Bool OfferTarget(const Target &target, MapObj *guard = NULL);
 
+    // Which of the given object locations can we hit from here without hitting an obstacle
+    U32 ClearLineOfFire(const Vector *locations, U32 count, U32 *clear);
+
     // InValidate Target
     void InValidateTarget();
 
@@ -806,6 +806,30 @@ namespace Weapon
   }
 
 
+  //
+  // Object::ClearLineOfFire
+  //
+  // Which of the given object locations can we hit from here without hitting an
+  // obstacle, sets bit i of 'clear' for each one, returns the number that are clear
+  //
+  U32 Object::ClearLineOfFire(const Vector *locations, U32 count, U32 *clear)
+  {
+    if (
+      !(type.style == Style::Projectile && 
+        type.projectileType->GetModel() == ProjectileModel::ArcTrajectory))
+    {
+      // Same tolerances as for a single object target
+      return (Ray::TerrainTestBatch(GetFiringLocation(), locations, count, 0.1F, 0.005F, FALSE, clear));
+    }
+    else
+    {
+      // Arcing projectiles pass this test always
+      Utils::Memset(clear, 0xFF, ((count + 31) >> 5) * sizeof(U32));
+      return (count);
+    }
+  }
+
+
   //
   // GetTargetPos
   //
@@ -88,6 +88,10 @@ namespace Tactical
 
     UnitObjFinder::HeuristicData heuristicData;
     UnitObj *obj = NULL;
+
+    // A pot shot, or any shot by a unit that can't move, is only worth
+    // taking at something we can hit from here
+    Weapon::Object *lineOfFire = (potShot || !subject->CanEverMove()) ? subject->GetWeapon() : NULL;
     
     // Has blind targetting time elapsed and our los is more than one cell
     if (subject->blindTarget.Test() && subject->GetSeeingRange() > 1)
@@ -112,7 +116,8 @@ namespace Tactical
             UnitObjFinder::MaxDanger, heuristicData, 
             (subject->UnitType()->CanFireIndirect() && subject->GetTeam()) ? 
               UnitObjIter::CanBeSeenByTeam : UnitObjIter::CanBeSeenBy, 
-            UnitObjIter::FilterDataUnit(Relation::ENEMY, subject)
+            UnitObjIter::FilterDataUnit(Relation::ENEMY, subject),
+            lineOfFire
           );
         }
         else
@@ -128,7 +133,8 @@ namespace Tactical
             UnitObjFinder::MaxDanger, heuristicData, 
             (subject->UnitType()->CanFireIndirect() && subject->GetTeam()) ? 
               UnitObjIter::CanBeSeenByTeam : UnitObjIter::CanBeSeenBy, 
-            UnitObjIter::FilterDataUnit(Relation::ENEMY, subject)
+            UnitObjIter::FilterDataUnit(Relation::ENEMY, subject),
+            lineOfFire
           );
 
           // Do a sweep for healers and if there's a healer healing this object, 
@@ -140,7 +146,8 @@ namespace Tactical
             UnitObjFinder::Healer, heuristicData, 
             (subject->UnitType()->CanFireIndirect() && subject->GetTeam()) ? 
               UnitObjIter::CanBeSeenByTeam : UnitObjIter::CanBeSeenBy, 
-            UnitObjIter::FilterDataUnit(Relation::ENEMY, subject)
+            UnitObjIter::FilterDataUnit(Relation::ENEMY, subject),
+            lineOfFire
           );
   
         }
@@ -154,7 +161,8 @@ namespace Tactical
             UnitObjFinder::MaxThreatMinDefense, heuristicData, 
             (subject->UnitType()->CanFireIndirect() && subject->GetTeam()) ? 
               UnitObjIter::CanBeSeenByTeam : UnitObjIter::CanBeSeenBy, 
-            UnitObjIter::FilterDataUnit(Relation::ENEMY, subject)
+            UnitObjIter::FilterDataUnit(Relation::ENEMY, subject),
+            lineOfFire
           );
         }
       }
@@ -167,7 +175,7 @@ namespace Tactical
       obj = UnitObjFinder::Find
       (
         UnitObjFinder::Random, heuristicData, UnitObjIter::CanBeSeenBy, 
-        UnitObjIter::FilterDataUnit(subject)
+        UnitObjIter::FilterDataUnit(subject), lineOfFire
       );
     }
 
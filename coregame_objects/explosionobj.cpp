@@ -17,6 +17,7 @@
 #include "gameobjctrl.h"
 #include "gametime.h"
 #include "mapobjiter.h"
+#include "worldctrl.h"
 #include "resolver.h"
 #include "unitobj.h"
 #include "mapobjctrl.h"
@@ -34,6 +35,68 @@
 #define SCOPE_CONFIG "ExplosionObj"
 
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// Explosion resolution
+//
+// Explosions queue themselves during object processing and are resolved
+// together afterwards.  Each cluster covered by any of them is walked once,
+// every object found is tested against the explosions covering the clusters
+// it is hooked into, then damage is worked out for all hits in one pass and
+// applied in explosion order, then object id order.
+//
+
+// Explosions to resolve this cycle, in processing order
+static NList<ExplosionObj> resolveList(&ExplosionObj::resolveNode);
+
+// Explosion being resolved
+struct Blast
+{
+  // The explosion and where it is
+  ExplosionObj *explosion;
+  Vector location;
+
+  // Squared outer range
+  F32 outer2;
+
+  // Last object tested against this explosion
+  U32 lastObj;
+};
+
+// Explosion covering a cluster, chained per cluster
+struct BlastLink
+{
+  U32 blast;
+  U32 next;
+};
+
+// Object in range of an explosion
+struct BlastHit
+{
+  U32 blast;
+  U32 id;
+  MapObj *obj;
+  F32 proximity2;
+  S32 deltaHp;
+};
+
+// End of a chain
+static const U32 BLAST_END = U32_MAX;
+
+// Scratch streams, grown as required
+static Array<Blast> blasts;
+static Array<BlastLink> blastLinks;
+static Array<BlastHit> blastHits;
+
+// First link for each cluster, only valid where the stamp is current
+static Array<U32> clusterHead;
+static Array<U32> clusterStamp;
+static U32 stamp;
+
+// Clusters touched this cycle
+static Array<U32> touched;
+
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 // Class ExplosionObjType - Base type class for all map object types
@@ -170,65 +233,59 @@ U32 ExplosionObjType::GetThreat(U32 armourClass)
 
 
 //
-// Apply
+// GetDeltaHp
 //
-void ExplosionObjType::Apply(const Vector &location, UnitObj *unit, Team *team)
+S32 ExplosionObjType::GetDeltaHp(MapObj *obj, F32 proximity2)
 {
-  MapObjIter::All i(NULL, MapObjIter::FilterData(location, areaOuter));
-  MapObj *obj;
+  // Is the object within the full damage area
+  F32 dist2 = proximity2 - areaInner2;
 
-  while ((obj = i.Next()) != NULL)
+  if (dist2 <= 0.0f)
   {
-    // Is the object within the full damage area
-    F32 dist2 = i.GetProximity2() - areaInner2;
-    S32 deltaHp;
+    // Apply the full damage to this object
+    return (-damage.GetAmount(obj->MapType()->GetArmourClass()));
+  }
 
-    //Vector dir = obj->WorldMatrix().posit - location;
-    //dir.Normalize();
+  F32 mod = 1.0f - (dist2 * areaDiff2Inv);
+  ASSERT(mod >= 0 && mod <= 1.0f)
 
-    if (dist2 <= 0.0f)
-    {
-      // Apply the full damage to this object
-      deltaHp = -damage.GetAmount(obj->MapType()->GetArmourClass());
-      obj->ModifyHitPoints(deltaHp, unit, team/*, &dir*/);
-    }
-    else
-    {
-      F32 mod = 1.0f - (dist2 * areaDiff2Inv);
-      ASSERT(mod >= 0 && mod <= 1.0f)
+  // Apply a proportional damage to this object
+  return (-(S32) (((F32) damage.GetAmount(obj->MapType()->GetArmourClass())) * mod));
+}
 
-      // Apply a proportional damage to this object
-      //Vector v = dir * mod;
-      deltaHp = -(S32) (((F32) damage.GetAmount(obj->MapType()->GetArmourClass())) * mod);
-      obj->ModifyHitPoints(deltaHp, unit, team/*, &v*/);
-    }
 
-    // Apply hit modifiers
-    if (ArmourClass::Lookup(damage.GetDamageId(), obj->MapType()->GetArmourClass()))
+//
+// Apply
+//
+void ExplosionObjType::Apply(MapObj *obj, S32 deltaHp, UnitObj *unit, Team *team)
+{
+  obj->ModifyHitPoints(deltaHp, unit, team);
+
+  // Apply hit modifiers
+  if (ArmourClass::Lookup(damage.GetDamageId(), obj->MapType()->GetArmourClass()))
+  {
+    damage.GetModifiers().Apply(obj);
+
+    // Set blind target time
+    if (blindTargetTime)
     {
-      damage.GetModifiers().Apply(obj);
+      UnitObj *unitObj = Promote::Object<UnitObjType, UnitObj>(obj);
 
-      // Set blind target time
-      if (blindTargetTime)
+      if (unitObj)
       {
-        UnitObj *unitObj = Promote::Object<UnitObjType, UnitObj>(obj);
-
-        if (unitObj)
-        {
-          unitObj->FlushTasks();
-          unitObj->StartBlindTarget(blindTargetTime);
-        }
+        unitObj->FlushTasks();
+        unitObj->StartBlindTarget(blindTargetTime);
       }
-
-      // Apply the generic effect
-      StartGenericFX(obj, 0x32FBA304); // "ExplosionObj::ApplyTarget"
     }
 
-    // Is there an action to execute
-    if (action && team)
-    {
-      Action::Execute(team, action);
-    }
+    // Apply the generic effect
+    StartGenericFX(obj, 0x32FBA304); // "ExplosionObj::ApplyTarget"
+  }
+
+  // Is there an action to execute
+  if (action && team)
+  {
+    Action::Execute(team, action);
   }
 }
 
@@ -267,6 +324,10 @@ ExplosionObj::~ExplosionObj()
 //
 void ExplosionObj::PreDelete()
 {
+  if (resolveNode.InUse())
+  {
+    resolveList.Unlink(this);
+  }
 
   // Call parent scope last
   MapObj::PreDelete();
@@ -370,8 +431,11 @@ void ExplosionObj::ProcessCycle()
 {
   PERF_S(("ExplosionObj"))
 
-  // Apply damage
-  ExplosionType()->Apply(Origin(), sourceUnit.GetPointer(), sourceTeam);
+  // Apply damage once object processing is done
+  if (!resolveNode.InUse())
+  {
+    resolveList.Append(this);
+  }
 
   // Has the persistence time expired ?
   if (GetBirthTime() + ExplosionType()->persist < GameTime::SimTotalTime())
@@ -383,6 +447,252 @@ void ExplosionObj::ProcessCycle()
 }
 
 
+//
+// CompareHits
+//
+// Order hits by explosion then object id
+//
+static int CDECL CompareHits(const void *e1, const void *e2)
+{
+  const BlastHit *h1 = (const BlastHit *) e1;
+  const BlastHit *h2 = (const BlastHit *) e2;
+
+  if (h1->blast != h2->blast)
+  {
+    return (h1->blast < h2->blast ? -1 : 1);
+  }
+  if (h1->id != h2->id)
+  {
+    return (h1->id < h2->id ? -1 : 1);
+  }
+  return (0);
+}
+
+
+//
+// ExplosionObj::ProcessExplosions
+//
+// Apply the damage of all explosions that went off this cycle
+//
+void ExplosionObj::ProcessExplosions()
+{
+  U32 blastCount = resolveList.GetCount();
+
+  if (!blastCount)
+  {
+    return;
+  }
+
+  PERF_S(("ExplosionObj::Resolve"))
+
+  U32 clusterCount = WorldCtrl::ClusterMapX() * WorldCtrl::ClusterMapZ();
+
+  if (clusterHead.count != clusterCount)
+  {
+    clusterHead.Alloc(clusterCount);
+    clusterStamp.Alloc(clusterCount);
+    touched.Alloc(clusterCount);
+    Utils::Memset(clusterStamp.data, 0, clusterStamp.size);
+    stamp = 0;
+  }
+  if (blasts.count < blastCount)
+  {
+    blasts.Alloc(blastCount + 16);
+  }
+
+  // A new stamp invalidates every cluster chain
+  if (++stamp == 0)
+  {
+    Utils::Memset(clusterStamp.data, 0, clusterStamp.size);
+    stamp = 1;
+  }
+
+  U32 linkCount = 0;
+  U32 touchedCount = 0;
+  U32 hitCount = 0;
+  U32 i, k;
+
+  // Gather the explosions and chain each onto the clusters it covers
+  for (k = 0; k < blastCount; k++)
+  {
+    ExplosionObj *explosion = resolveList.GetHead();
+    resolveList.Unlink(explosion);
+
+    Blast &b = blasts.data[k];
+    F32 outer = explosion->ExplosionType()->GetAreaOuter();
+
+    b.explosion = explosion;
+    b.location = explosion->Origin();
+    b.outer2 = outer * outer;
+    b.lastObj = BLAST_END;
+
+    // Same cluster range as a map object iterator
+    S32 x0 = Clamp((S32) 0, (S32) ((b.location.x - outer) * WorldCtrl::ClusterSizeInv()), (S32) (WorldCtrl::ClusterMapX() - 1));
+    S32 x1 = Clamp((S32) 0, (S32) ((b.location.x + outer) * WorldCtrl::ClusterSizeInv()), (S32) (WorldCtrl::ClusterMapX() - 1));
+    S32 z0 = Clamp((S32) 0, (S32) ((b.location.z - outer) * WorldCtrl::ClusterSizeInv()), (S32) (WorldCtrl::ClusterMapZ() - 1));
+    S32 z1 = Clamp((S32) 0, (S32) ((b.location.z + outer) * WorldCtrl::ClusterSizeInv()), (S32) (WorldCtrl::ClusterMapZ() - 1));
+
+    U32 needed = linkCount + (x1 - x0 + 1) * (z1 - z0 + 1);
+
+    if (blastLinks.count < needed)
+    {
+      Array<BlastLink> grown(needed * 2);
+
+      if (linkCount)
+      {
+        memcpy(grown.data, blastLinks.data, linkCount * sizeof (BlastLink));
+      }
+      blastLinks.Swap(grown);
+    }
+
+    for (S32 z = z0; z <= z1; z++)
+    {
+      for (S32 x = x0; x <= x1; x++)
+      {
+        U32 c = WorldCtrl::GetClusterIndex(x, z);
+
+        if (clusterStamp.data[c] != stamp)
+        {
+          clusterStamp.data[c] = stamp;
+          clusterHead.data[c] = BLAST_END;
+          touched.data[touchedCount++] = c;
+        }
+
+        BlastLink &link = blastLinks.data[linkCount];
+        link.blast = k;
+        link.next = clusterHead.data[c];
+        clusterHead.data[c] = linkCount++;
+      }
+    }
+  }
+
+  // Walk each touched cluster once, testing its objects against the
+  // explosions covering any cluster the object is hooked into
+  MapObjIter::IncIterTicker();
+  U32 ticker = MapObjIter::GetIterTicker();
+  U32 objCount = 0;
+
+  for (i = 0; i < touchedCount; i++)
+  {
+    for (NList<MapObj>::Iterator o(&WorldCtrl::GetCluster(touched.data[i])->listObjs); *o; o++)
+    {
+      MapObj *obj = *o;
+
+      if (obj->iterTicker == ticker)
+      {
+        continue;
+      }
+      obj->iterTicker = ticker;
+      objCount++;
+
+      F32 radius = obj->ObjectBounds().Radius();
+
+      for (U32 n = 0; n < 4; n++)
+      {
+        MapCluster *clust = obj->clustList[n];
+
+        if (!clust)
+        {
+          continue;
+        }
+
+        U32 c = clust->GetIndex();
+
+        if (clusterStamp.data[c] != stamp)
+        {
+          continue;
+        }
+
+        for (U32 l = clusterHead.data[c]; l != BLAST_END; l = blastLinks.data[l].next)
+        {
+          Blast &b = blasts.data[blastLinks.data[l].blast];
+
+          // Already tested through another cluster
+          if (b.lastObj == objCount)
+          {
+            continue;
+          }
+          b.lastObj = objCount;
+
+          // Is any part of this object's bounds within range
+          Vector v = obj->Origin() - b.location;
+          F32 proximity = Max<F32>(0.0F, v.Magnitude() - radius);
+          F32 proximity2 = proximity * proximity;
+
+          if (proximity2 > b.outer2)
+          {
+            continue;
+          }
+
+          if (blastHits.count <= hitCount)
+          {
+            Array<BlastHit> grown(hitCount * 2 + 64);
+
+            if (hitCount)
+            {
+              memcpy(grown.data, blastHits.data, hitCount * sizeof (BlastHit));
+            }
+            blastHits.Swap(grown);
+          }
+
+          BlastHit &hit = blastHits.data[hitCount++];
+          hit.blast = blastLinks.data[l].blast;
+          hit.id = obj->Id();
+          hit.obj = obj;
+          hit.proximity2 = proximity2;
+        }
+      }
+    }
+  }
+
+  // Falloff for every hit
+  for (i = 0; i < hitCount; i++)
+  {
+    BlastHit &hit = blastHits.data[i];
+    hit.deltaHp = blasts.data[hit.blast].explosion->ExplosionType()->GetDeltaHp(hit.obj, hit.proximity2);
+  }
+
+  // Apply in a fixed order
+  qsort(blastHits.data, hitCount, sizeof (BlastHit), CompareHits);
+
+  for (i = 0; i < hitCount; i++)
+  {
+    BlastHit &hit = blastHits.data[i];
+
+    // Earlier hits may have taken it off the map
+    if (!hit.obj->OnMap())
+    {
+      continue;
+    }
+
+    ExplosionObj *explosion = blasts.data[hit.blast].explosion;
+    explosion->ExplosionType()->Apply(hit.obj, hit.deltaHp, explosion->sourceUnit.GetPointer(), explosion->sourceTeam);
+  }
+
+  PERF_E(("ExplosionObj::Resolve"))
+}
+
+
+//
+// ExplosionObj::ReleaseExplosions
+//
+// Free the explosion resolution streams
+//
+void ExplosionObj::ReleaseExplosions()
+{
+  resolveList.UnlinkAll();
+
+  blasts.Release();
+  blastLinks.Release();
+  blastHits.Release();
+  clusterHead.Release();
+  clusterStamp.Release();
+  touched.Release();
+
+  stamp = 0;
+}
+
+
 //
 // ExplosionObj::RenderDebug
 //
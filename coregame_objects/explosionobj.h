@@ -89,8 +89,11 @@ public:
 
 private:
 
-  // Apply
-  void Apply(const Vector &location, UnitObj *unit, Team *team);
+  // Hit point change for an object at squared distance 'proximity2'
+  S32 GetDeltaHp(MapObj *obj, F32 proximity2);
+
+  // Apply a hit to a single object
+  void Apply(MapObj *obj, S32 deltaHp, UnitObj *unit, Team *team);
 
 public:
 
@@ -148,6 +151,11 @@ protected:
   // Team which started this explosion (only used if unit is invalid)
   Team *sourceTeam;
 
+public:
+
+  // Node in the list of explosions to resolve this cycle
+  NList<ExplosionObj>::Node resolveNode;
+
 public:
 
   // Constructor and destructor
@@ -173,6 +181,12 @@ public:
   // Render debug
   void RenderDebug();
 
+  // Apply the damage of all explosions that went off this cycle
+  static void ProcessExplosions();
+
+  // Free the explosion resolution streams
+  static void ReleaseExplosions();
+
 public:
 
   // Get pointer to type
@@ -27,6 +27,7 @@
 #include "sight.h"
 #include "unitobj.h"
 #include "mapobj.h"
+#include "explosionobj.h"
 #include "sync.h"
 #include "common.h"
 #include "main.h"
@@ -285,6 +286,12 @@ namespace MapObjCtrl
     // Cleanup the display list
     listDisplay.UnlinkAll();
 
+    // Release cull blocks
+    Cull::Release();
+
+    // Release the explosion streams
+    ExplosionObj::ReleaseExplosions();
+
     // System now shutdown
     sysInit = FALSE;
   }
@@ -313,12 +320,319 @@ namespace MapObjCtrl
     }
   }
 
+  ///////////////////////////////////////////////////////////////////////////////
+  //
+  // NameSpace Cull - Coarse visibility over blocks of map clusters
+  //
+  // Each block keeps the extents of the objects that were tested in it last
+  // frame.  A block whose extents are outside the frustum culls its objects
+  // without testing them one at a time; an object that doesn't fit the
+  // extents is always tested itself.  Blocks with no seen cells let objects
+  // skip their sight lookup; a shrouded block is only rescanned after the
+  // team sees a new cell.
+  //
+  namespace Cull
+  {
+    // Clusters per block side
+    const U32 BLOCKSHIFT = 2;
+
+    struct Block
+    {
+      // Metre extents of the clusters in the block
+      F32 x0, x1, z0, z1;
+
+      // Object extents used this frame, and those gathered for the next
+      F32 y0, y1, reach;
+      F32 nextY0, nextY1, nextReach;
+
+      U32 outside   : 1,      // extents are outside the frustum
+          seen      : 1,      // a cell has been seen by the team
+          shrouded  : 1,      // no cell seen as of the last scan
+          scanned   : 1;      // shrouded is up to date
+    };
+
+    static Array<Block> blocks;
+    static U32 blockX, blockZ;
+    static F32 blockSize;
+    static Team * lastTeam;
+    static U32 lastSeenSerial;
+
+    // Counters
+    static U32 blocksOut, tested, culled, shrouded;
+
+
+    //
+    // Release
+    //
+    static void Release()
+    {
+      blocks.Release();
+      blockX = blockZ = 0;
+      lastTeam = NULL;
+    }
+
+
+    //
+    // Setup
+    //
+    // Fit blocks to the current map
+    //
+    static void Setup()
+    {
+      U32 clusX = WorldCtrl::ClusterMapX();
+      U32 clusZ = WorldCtrl::ClusterMapZ();
+
+      blockX = (clusX + (1 << BLOCKSHIFT) - 1) >> BLOCKSHIFT;
+      blockZ = (clusZ + (1 << BLOCKSHIFT) - 1) >> BLOCKSHIFT;
+      blockSize = WorldCtrl::ClusterSize() * F32(1 << BLOCKSHIFT);
+
+      blocks.Alloc(blockX * blockZ);
+
+      for (U32 z = 0; z < blockZ; z++)
+      {
+        for (U32 x = 0; x < blockX; x++)
+        {
+          Block & b = blocks[z * blockX + x];
+
+          MapCluster * c0 = WorldCtrl::GetCluster(x << BLOCKSHIFT, z << BLOCKSHIFT);
+          MapCluster * c1 = WorldCtrl::GetCluster
+          (
+            Min<U32>(((x + 1) << BLOCKSHIFT) - 1, clusX - 1), 
+            Min<U32>(((z + 1) << BLOCKSHIFT) - 1, clusZ - 1)
+          );
+
+          b.x0 = c0->x0;
+          b.z0 = c0->z0;
+          b.x1 = c1->x1;
+          b.z1 = c1->z1;
+
+          b.y0 = b.nextY0 = F32_MAX;
+          b.y1 = b.nextY1 = -F32_MAX;
+          b.reach = b.nextReach = 0.0f;
+
+          b.outside = b.seen = b.shrouded = b.scanned = FALSE;
+        }
+      }
+    }
+
+
+    //
+    // Start
+    //
+    // Classify the blocks against the current camera
+    //
+    static void Start(Team * team)
+    {
+      // Rebuild if the map has changed size
+      if 
+      (
+        !blocks.count 
+        || blockX != ((WorldCtrl::ClusterMapX() + (1 << BLOCKSHIFT) - 1) >> BLOCKSHIFT)
+        || blockZ != ((WorldCtrl::ClusterMapZ() + (1 << BLOCKSHIFT) - 1) >> BLOCKSHIFT)
+      )
+      {
+        Setup();
+      }
+
+      // Seen cells are only ever added, so this holds until the team changes
+      Bool resetSeen = team != lastTeam;
+      lastTeam = team;
+
+      // Shrouded blocks hold until the team sees a new cell
+      U32 seenSerial = team ? Sight::SeenSerial(team) : 0;
+      Bool rescan = resetSeen || seenSerial != lastSeenSerial;
+      lastSeenSerial = seenSerial;
+
+      blocksOut = tested = culled = shrouded = 0;
+
+      Camera & camera = Vid::CurCamera();
+
+      for (Block * b = blocks.data, * e = blocks.data + blocks.count; b < e; b++)
+      {
+        if (resetSeen)
+        {
+          b->seen = FALSE;
+        }
+        if (rescan)
+        {
+          b->scanned = FALSE;
+        }
+
+        // Use what was gathered last frame
+        b->y0 = b->nextY0;
+        b->y1 = b->nextY1;
+        b->reach = b->nextReach;
+        b->nextY0 = F32_MAX;
+        b->nextY1 = -F32_MAX;
+        b->nextReach = 0.0f;
+
+        // Empty blocks cull nothing that isn't tested anyway
+        if (b->y0 > b->y1)
+        {
+          b->outside = TRUE;
+        }
+        else
+        {
+          F32 hx = (b->x1 - b->x0) * 0.5f + b->reach;
+          F32 hz = (b->z1 - b->z0) * 0.5f + b->reach;
+          F32 hy = (b->y1 - b->y0) * 0.5f;
+
+          Vector origin((b->x0 + b->x1) * 0.5f, (b->y0 + b->y1) * 0.5f, (b->z0 + b->z1) * 0.5f);
+
+          b->outside = camera.SphereTest(origin, F32(sqrt(hx * hx + hy * hy + hz * hz))) == clipOUTSIDE;
+        }
+
+        if (b->outside)
+        {
+          blocksOut++;
+        }
+      }
+    }
+
+
+    //
+    // BlockAt
+    //
+    static Block & BlockAt(F32 x, F32 z)
+    {
+      S32 bx = Clamp<S32>(0, Utils::FtoL((x - blocks[0].x0) / blockSize), blockX - 1);
+      S32 bz = Clamp<S32>(0, Utils::FtoL((z - blocks[0].z0) / blockSize), blockZ - 1);
+
+      return (blocks[bz * blockX + bx]);
+    }
+
+
+    //
+    // Test
+    //
+    // Frustum test an object, using its block where possible
+    //
+    static U32 Test(MeshEnt & ent)
+    {
+      if (!*Vid::Var::clipBlocks || !blocks.count)
+      {
+        return (ent.BoundsTest());
+      }
+
+      tested++;
+
+      const Matrix & m = ent.WorldMatrixRender();
+      const Bounds & bounds = ent.ObjectBoundsRender();
+
+      // World sphere about the object's origin
+      F32 s2 = Max<F32>(m.right.Magnitude2(), Max<F32>(m.up.Magnitude2(), m.front.Magnitude2()));
+      F32 r = bounds.Radius() + bounds.Offset().Magnitude();
+      if (s2 > 1.0f)
+      {
+        r *= F32(sqrt(s2));
+      }
+
+      Block & b = BlockAt(m.posit.x, m.posit.z);
+
+      F32 dx = Max<F32>(0.0f, Max<F32>(b.x0 - m.posit.x, m.posit.x - b.x1));
+      F32 dz = Max<F32>(0.0f, Max<F32>(b.z0 - m.posit.z, m.posit.z - b.z1));
+      F32 reach = r + Max<F32>(dx, dz);
+      F32 y0 = m.posit.y - r;
+      F32 y1 = m.posit.y + r;
+
+      b.nextY0 = Min<F32>(b.nextY0, y0);
+      b.nextY1 = Max<F32>(b.nextY1, y1);
+      b.nextReach = Max<F32>(b.nextReach, reach);
+
+      if (reach > b.reach || y0 < b.y0 || y1 > b.y1)
+      {
+        // Doesn't fit the extents that the block was tested with
+        b.outside = FALSE;
+      }
+      else if (b.outside)
+      {
+        culled++;
+        ent.clipFlagCache = clipOUTSIDE;
+        return (clipOUTSIDE);
+      }
+
+      return (ent.BoundsTest());
+    }
+
+
+    //
+    // Shrouded
+    //
+    // TRUE if the object sits in a block where no cell has been seen by team
+    //
+    static Bool Shrouded(MapObj * obj, Team * team)
+    {
+      if (!*Vid::Var::clipBlocks || !blocks.count || obj->GetParent() || obj->GetFootInstance())
+      {
+        return (FALSE);
+      }
+
+      U32 cellShift = WC_CLUSTERCELLSHIFT + BLOCKSHIFT;
+      U32 bx = U32(obj->cellX) >> cellShift;
+      U32 bz = U32(obj->cellZ) >> cellShift;
+
+      if (bx >= blockX || bz >= blockZ)
+      {
+        return (FALSE);
+      }
+
+      Block & b = blocks[bz * blockX + bx];
+
+      if (b.seen)
+      {
+        return (FALSE);
+      }
+
+      if (!b.scanned)
+      {
+        b.scanned = TRUE;
+        b.shrouded = TRUE;
+
+        U32 x0 = bx << cellShift, x1 = Min<U32>((bx + 1) << cellShift, WorldCtrl::CellMapX());
+        U32 z0 = bz << cellShift, z1 = Min<U32>((bz + 1) << cellShift, WorldCtrl::CellMapZ());
+
+        for (U32 z = z0; z < z1 && b.shrouded; z++)
+        {
+          for (U32 x = x0; x < x1; x++)
+          {
+            if (Sight::Seen(x, z, team))
+            {
+              b.seen = TRUE;
+              b.shrouded = FALSE;
+              break;
+            }
+          }
+        }
+      }
+
+      if (b.shrouded)
+      {
+        shrouded++;
+      }
+
+      return (b.shrouded);
+    }
+
+
+    //
+    // Report
+    //
+    static void Report()
+    {
+      PERF_COUNT("Cull blocks out", blocksOut, 0)
+      PERF_COUNT("Cull tested", tested, 0)
+      PERF_COUNT("Cull culled", culled, 0)
+      PERF_COUNT("Cull shrouded", shrouded, 0)
+    }
+  }
+
+
   //
   // SetFogTarget
   //
-  // Setup fog of war
+  // Setup fog of war, 'unseen' if the object's location is known to be unseen
   //
-  static Bool SetFogTarget( MapObj * obj, Team * team, Bool immediate = FALSE)
+  static Bool SetFogTarget( MapObj * obj, Team * team, Bool immediate = FALSE, Bool unseen = FALSE)
   {
     // Do we need to check line of sight for a team
     Bool fogFilter = TRUE;
@@ -352,7 +666,14 @@ namespace MapObjCtrl
       // Either check real values, or see everything
       if (fogFilter)
       {
-        obj->GetSeenVisible(team, seen, visible);
+        if (unseen)
+        {
+          seen = visible = FALSE;
+        }
+        else
+        {
+          obj->GetSeenVisible(team, seen, visible);
+        }
       }
       else
       {
@@ -741,19 +1062,35 @@ namespace MapObjCtrl
   // Simulate
   //
   // Animate the MapObjs' current cycle
+  // Objects out of the last display list skip keyframe sampling;
+  // BuildDisplayList catches them up when they come back into view
   //
   void SimulateInt(F32 dt)
   { 
+    Bool skip = *Vid::Var::animSkipHidden;
+
+    if (*Vid::Var::animBatch)
+    {
+      MeshEnt::StartIntBatch();
+    }
+
     NList<MapObj>::Iterator li(&listPrimitive); 
     while (MapObj * obj = li++)
     {
       if (!obj->GetParent())
       {
+        MeshEnt & ent = obj->Mesh();
+
         // ent function clips dt
         //
-        obj->Mesh().SimulateInt(dt); 
+        ent.SimulateInt(dt, TRUE, skip && !ent.inView); 
       }
     }
+
+    if (MeshEnt::intBatching)
+    {
+      MeshEnt::FlushIntBatch();
+    }
   }
 
 
@@ -809,6 +1146,11 @@ namespace MapObjCtrl
       fogFilter = FALSE;
     }
 
+    // Classify cluster blocks for this camera
+    Cull::Start(team);
+
+    Bool skip = *Vid::Var::animSkipHidden;
+
     // Step over all objects on the map
     U32 oldTime = U32_MAX;    // find the oldest shadow
     MeshEnt * old = NULL;
@@ -818,10 +1160,14 @@ namespace MapObjCtrl
       MeshEnt & ent = obj->Mesh();
       MapObjType * type = obj->MapType();
 
+      // SimulateInt already ran with last frame's view
+      Bool wasInView = ent.inView;
+
       // Don't bother will null objects
       if (type->IsNullObj())
       {
         ent.visible = FALSE;
+        ent.inView = FALSE;
         continue;
       }
 
@@ -829,7 +1175,7 @@ namespace MapObjCtrl
       //
       if (type->HasShadow() && ent.shadowType >= MeshRoot::shadowSEMILIVE)
       {
-        if (ent.shadowTime == 0 || ent.dirtyShadow || ent.shadowType == MeshRoot::shadowLIVE)
+        if (ent.shadowTime == 0 || ent.dirtyShadow || ent.shadowType == MeshRoot::shadowLIVE || !ent.ShadowCacheValid())
         {
           // first time or moved or animated
           ent.RenderShadowTexture();
@@ -846,7 +1192,8 @@ namespace MapObjCtrl
       // Basic simulation for all objects at frame rate
       obj->UpdateIntBasic(Main::elapSecs, simFrame);
 
-      ent.visible = SetFogTarget( obj, team);
+      ent.visible = SetFogTarget( obj, team, FALSE, fogFilter && team && Cull::Shrouded( obj, team));
+      ent.inView = FALSE;
       if (!ent.visible)
       {
         continue;
@@ -859,13 +1206,16 @@ namespace MapObjCtrl
         if (TerrainData::BoundsTestShadowWithWater( ent))
         {
           *(indexShadow++) = &ent;
+          ent.inView = TRUE;
         }
       }
 
       // add to display list if object is on the screen
       //
-      if (ent.BoundsTest() != clipOUTSIDE)
+      if (Cull::Test( ent) != clipOUTSIDE)
       {
+        ent.inView = TRUE;
+
         if (indexMeshEnt < lastMeshEnt)
         {
           *indexMeshEnt = &ent;
@@ -879,6 +1229,12 @@ namespace MapObjCtrl
         listDisplay.Append(obj);
       }
 
+      // sample the pose SimulateInt skipped before it's drawn
+      if (skip && ent.inView && !wasInView && !obj->GetParent())
+      {
+        ent.SimulateInt( 0.0f, TRUE, FALSE);
+      }
+
       NList<Vid::Light::Obj>::Iterator l(&obj->GetLights());
       while (Vid::Light::Obj * light = l++)
       {
@@ -903,6 +1259,10 @@ namespace MapObjCtrl
     {
       old->RenderShadowTexture();
     }
+
+    Vid::Governor::SetLoad( Vid::Governor::stageMESH, (indexMeshEnt - arrayMeshEnt) + (indexShadow - arrayShadow));
+
+    Cull::Report();
   }
 
 
@@ -949,7 +1309,9 @@ namespace MapObjCtrl
       (*light)->RenderSingle();
     }
 
-    // Render all of MeshEnt nodes
+    // Render all of MeshEnt nodes; runs of like ents share vertex streams
+    Mesh::Manager::SortInstances( arrayMeshEnt, indexMeshEnt - arrayMeshEnt);
+
     for (MeshEnt ** index = arrayMeshEnt; index < indexMeshEnt; index++)
     {
       ASSERT( (index - arrayMeshEnt) <= MAX_MESHENTS && *index);
@@ -957,6 +1319,7 @@ namespace MapObjCtrl
       (*index)->RenderSingle();
 
     }
+    Mesh::Manager::InstancesDone();
   }
 
 
@@ -239,7 +239,7 @@ namespace UnitObjFinder
   // Find an object using the given heuristic, 
   // heuristic data, filter, filter data
   //
-  UnitObj * Find(Heuristic heuristic, HeuristicData &heuristicData, UnitObjIter::Filter filter, const UnitObjIter::FilterData &filterData)
+  UnitObj * Find(Heuristic heuristic, HeuristicData &heuristicData, UnitObjIter::Filter filter, const UnitObjIter::FilterData &filterData, Weapon::Object *lineOfFire)
   {
     ASSERT(heuristic)
 
@@ -247,6 +247,50 @@ namespace UnitObjFinder
     UnitObjIter::Tactical i(filter, filterData);
     UnitObj *obj;
 
+    // Only offer objects the weapon can hit from where it is
+    if (lineOfFire)
+    {
+      // Candidates are ray tested in batches from the firing location
+      enum { BATCH = 64 };
+
+      UnitObj *objs[BATCH];
+      F32 proximity2[BATCH];
+      Vector locations[BATCH];
+      U32 clear[BATCH >> 5];
+      U32 count = 0;
+
+      do
+      {
+        if ((obj = i.Next()) != NULL)
+        {
+          objs[count] = obj;
+          proximity2[count] = i.GetProximity2();
+          locations[count] = obj->Origin();
+          count++;
+        }
+
+        // Flush the batch when it fills up or the iterator is done
+        if (count && (!obj || count == BATCH))
+        {
+          if (lineOfFire->ClearLineOfFire(locations, count, clear))
+          {
+            // Run the heuristic in iteration order to keep the result in sync
+            for (U32 n = 0; n < count; n++)
+            {
+              if (clear[n >> 5] & (1 << (n & 31)))
+              {
+                heuristic(objs[n], proximity2[n], heuristicData);
+              }
+            }
+          }
+          count = 0;
+        }
+      }
+      while (obj);
+
+      return (heuristicData.winner);
+    }
+
     while ((obj = i.Next()) != NULL)
     {
       heuristic(obj, i.GetProximity2(), heuristicData);
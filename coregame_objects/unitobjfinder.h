@@ -20,6 +20,16 @@
 #include "restoreobj.h"
 
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// Forward Declarations
+//
+namespace Weapon
+{
+  class Object;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 // NameSpace UnitObjFinder
@@ -155,7 +165,8 @@ namespace UnitObjFinder
   void Restore(UnitObj *obj, F32 distance2, HeuristicData &heuristicData);
 
   // Find an object using the given heuristic, heuristic data, filter, filter data
-  UnitObj * Find(Heuristic heuristic, HeuristicData &heuristicData, UnitObjIter::Filter filter, const UnitObjIter::FilterData &filterData); 
+  // and optionally only those objects the given weapon has a clear line of fire to
+  UnitObj * Find(Heuristic heuristic, HeuristicData &heuristicData, UnitObjIter::Filter filter, const UnitObjIter::FilterData &filterData, Weapon::Object *lineOfFire = NULL); 
 
 }
 
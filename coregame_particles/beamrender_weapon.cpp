@@ -136,7 +136,7 @@ void BeamRenderWeapon::Render()
   Vector spos, & pos0 = points[0];
   Vid::TransformFromWorld( spos, pos0);
 
-  F32 df  = (1.0f - *Vid::Var::perfs[2]);
+  F32 df  = (1.0f - Vid::renderState.perfs[2]);
   F32 dfp = df * particle->proto->priority;
 
   if (pclass->flares && dfp < .5555f)
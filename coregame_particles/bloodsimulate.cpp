@@ -25,6 +25,8 @@
 BloodSimulateClass::BloodSimulateClass()
 : ParticleClass()
 {
+  // has its own simulation
+  pooled = FALSE;
 }
 
 
@@ -29,6 +29,8 @@
 //
 ChunkSimulateClass::ChunkSimulateClass() : ParticleClass()
 {
+  // has its own simulation
+  pooled = FALSE;
 }
 
 
@@ -21,6 +21,8 @@
 //
 DustSimulateClass::DustSimulateClass() : ParticleClass()
 {
+  // has its own simulation
+  pooled = FALSE;
 }
 
 
@@ -40,6 +40,68 @@ void EmberSimulateClass::Setup(FScope *fScope)
 }
 
 
+//
+// Simulate all pooled embers
+//
+void EmberSimulateClass::SimulatePool(F32 dt)
+{
+  U32 i;
+
+	// apply gravity
+  F32 fall = dt * PhysicsCtrl::GetGravity() * gravity;
+
+  for (i = 0; i < pool.count; i++)
+  {
+    pool.veloc.data[i].y -= fall;
+  }
+
+  // apply drag
+  if (drag)
+  {
+    F32 damp = 1.0F - drag;
+
+    for (i = 0; i < pool.count; i++)
+    {
+      pool.veloc.data[i] *= damp;
+      pool.omega.data[i] *= damp;
+    }
+  }
+
+  ParticleClass::SimulatePool(dt);
+
+  for (i = 0; i < pool.count; i++)
+  {
+    if (!pool.Alive(i))
+    {
+      continue;
+    }
+
+    Vector &posit = pool.posit.data[i];
+
+    if (!Terrain::MeterOnMap( posit.x, posit.z))
+    {
+      delete pool.owner.data[i];
+      continue;
+    }
+
+	  // if the ember collides with the ground...
+	  Vector normal;
+    F32 floor = TerrainData::FindFloorWithWater(posit.x, posit.z, &normal);
+
+    if (floor >= posit.y)
+	  {
+      // clamp to floor
+      posit.y = floor;
+
+		  // reflect velocity around surface normal
+      Vector &veloc = pool.veloc.data[i];
+		  F32 dot = veloc.Dot(normal);
+      veloc = (veloc * 0.5F) - (normal * dot);
+	  }
+  }
+}
+
+
 //
 // Build a new ember simulator
 //
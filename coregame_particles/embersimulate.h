@@ -40,6 +40,9 @@ public:
   // Configure the class
   void Setup(FScope *fScope);
 
+  // simulate all pooled embers
+  virtual void SimulatePool(F32 dt);
+
 	// build a new ember simulator
 	virtual Particle *Build(
     const Matrix &matrix,
@@ -77,19 +77,20 @@ void GroundSpriteRender::Render()
   if (Visible() != clipOUTSIDE)
   {
 	  GroundSpriteRenderClass *pclass = (GroundSpriteRenderClass *)proto;
+    const State & s = Front();
 
     if (pclass->water)
     {
       TerrainData::RenderGroundSpriteWithWater( 
-        particle->matrix.posit, scaleAnim.Current().scale, particle->matrix.front,
-        texture, colorAnim.Current().color, proto->data.blend,
+        particle->matrix.posit, s.scale, particle->matrix.front,
+        s.texture, s.color, proto->data.blend,
         UVPair(0,0), UVPair(1,0), UVPair(1,1), proto->data.sorting);
     }
     else
     {
       TerrainData::RenderGroundSprite( 
-        particle->matrix.posit, scaleAnim.Current().scale, particle->matrix.front,
-        texture, colorAnim.Current().color, proto->data.blend, 
+        particle->matrix.posit, s.scale, particle->matrix.front,
+        s.texture, s.color, proto->data.blend, 
         UVPair(0,0), UVPair(1,0), UVPair(1,1), proto->data.sorting);
     }
   }
@@ -116,7 +117,7 @@ void AirGroundSpriteRender::Render()
 	  AirGroundSpriteRenderClass *pclass = (AirGroundSpriteRenderClass *)proto;
 
     Matrix & m = particle->matrix;
-
+    const State & s = Front();
 
     // if the blood collides with the ground...
     if (particle->stopped)
@@ -124,22 +125,22 @@ void AirGroundSpriteRender::Render()
       if (pclass->water)
       {
         TerrainData::RenderGroundSpriteWithWater( 
-          m.posit, scaleAnim.Current().scale, m.front,
-          texture, colorAnim.Current().color, proto->data.blend,
+          m.posit, s.scale, m.front,
+          s.texture, s.color, proto->data.blend,
           UVPair(0,0), UVPair(1,0), UVPair(1,1), proto->data.sorting);
       }
       else
       {
         TerrainData::RenderGroundSprite(
-          m.posit, scaleAnim.Current().scale, m.front,
-          texture, colorAnim.Current().color, proto->data.blend, 
+          m.posit, s.scale, m.front,
+          s.texture, s.color, proto->data.blend, 
           UVPair(0,0), UVPair(1,0), UVPair(1,1), proto->data.sorting);
         }
     }
     else
     {
-      Vid::RenderSprite( TRUE, m.posit, scaleAnim.Current().scale, 
-        texture, colorAnim.Current().color, pclass->data.blend, U16(pclass->data.sorting),
+      Vid::RenderSprite( TRUE, m.posit, s.scale, 
+        s.texture, s.color, pclass->data.blend, U16(pclass->data.sorting),
         m.right.x != 0 || m.right.y != 0 ? m.right : m.front);
     }
   }
@@ -17,6 +17,301 @@
 #include "tracksys.h"
 
 
+//
+// Spin
+//
+// Apply angular velocity to an orientation
+//
+static void Spin(Matrix &matrix, const Vector &omega, F32 dt)
+{
+  Quaternion q(matrix);
+  if (omega.x)
+  {
+    q *= Quaternion( omega.x * dt, Matrix::I.right);
+  }
+  if (omega.y)
+  {
+    q *= Quaternion( omega.y * dt, Matrix::I.up);
+  }
+  if (omega.z)
+  {
+    q *= Quaternion( omega.z * dt, Matrix::I.up);
+  }
+  matrix.Set( q);
+}
+
+
+//
+// GrowStream
+//
+// Reallocate a pool stream, keeping the used entries
+//
+template <class DATA> static void GrowStream(Array<DATA> &stream, U32 used, U32 size)
+{
+  Array<DATA> temp(size);
+
+  if (used)
+  {
+    Utils::Memcpy(temp.data, stream.data, used * sizeof(DATA));
+  }
+  stream.Swap(temp);
+}
+
+
+//
+// ParticlePool::ParticlePool
+//
+ParticlePool::ParticlePool()
+: proto(NULL),
+  count(0),
+  dead(0)
+{
+}
+
+
+//
+// ParticlePool::~ParticlePool
+//
+ParticlePool::~ParticlePool()
+{
+  if (node.InUse())
+  {
+    ParticleSystem::DeletePool(this);
+  }
+  Release();
+}
+
+
+//
+// ParticlePool::Release
+//
+void ParticlePool::Release()
+{
+  ASSERT(count == dead)
+
+  posit.Release();
+  veloc.Release();
+  omega.Release();
+  timer.Release();
+  flags.Release();
+  owner.Release();
+
+  count = dead = 0;
+}
+
+
+//
+// ParticlePool::Grow
+//
+void ParticlePool::Grow(U32 size)
+{
+  ASSERT(size > count)
+
+  GrowStream(posit, count, size);
+  GrowStream(veloc, count, size);
+  GrowStream(omega, count, size);
+  GrowStream(timer, count, size);
+  GrowStream(flags, count, size);
+  GrowStream(owner, count, size);
+}
+
+
+//
+// ParticlePool::Add
+//
+// Add a particle, returns its index
+//
+U32 ParticlePool::Add(Particle *p)
+{
+  ASSERT(p)
+
+  if (count == flags.count)
+  {
+    Grow(Max<U32>(64, count << 1));
+  }
+
+  U32 index = count++;
+
+  posit.data[index] = p->matrix.posit;
+  veloc.data[index] = p->veloc;
+  omega.data[index] = p->omega;
+  timer.data[index] = p->timer;
+  flags.data[index] = (p->omega.x || p->omega.y || p->omega.z) ? flagSPIN : 0;
+  owner.data[index] = p;
+
+  if (!node.InUse())
+  {
+    ParticleSystem::AddPool(this);
+  }
+  return (index);
+}
+
+
+//
+// ParticlePool::Remove
+//
+// Mark an entry as dead, it is removed by the next Compact
+//
+void ParticlePool::Remove(U32 index)
+{
+  ASSERT(index < count && Alive(index))
+
+  flags.data[index] |= flagDEAD;
+  owner.data[index] = NULL;
+  dead++;
+}
+
+
+//
+// ParticlePool::Gather
+//
+// Copy the owning particles' state into the streams, the particle objects
+// stay authoritative so changes made to them outside the pool are kept
+//
+void ParticlePool::Gather()
+{
+  for (U32 i = 0; i < count; i++)
+  {
+    if (Alive(i))
+    {
+      Particle *p = owner.data[i];
+
+      posit.data[i] = p->matrix.posit;
+      veloc.data[i] = p->veloc;
+      omega.data[i] = p->omega;
+      timer.data[i] = p->timer;
+
+      if (p->omega.x || p->omega.y || p->omega.z)
+      {
+        flags.data[i] |= flagSPIN;
+      }
+      else
+      {
+        flags.data[i] &= ~flagSPIN;
+      }
+    }
+  }
+}
+
+
+//
+// ParticlePool::Integrate
+//
+// Advance the timer, position and orientation of all live entries
+//
+void ParticlePool::Integrate(F32 dt)
+{
+  Vector *p = posit.data;
+  Vector *v = veloc.data;
+  F32 *t = timer.data;
+  U32 i;
+
+  // dead entries are advanced as well, it keeps the loop free of branches
+  for (i = 0; i < count; i++)
+  {
+    t[i] += dt;
+    p[i] += v[i] * dt;
+  }
+
+  // orientation lives in the particle matrix
+  for (i = 0; i < count; i++)
+  {
+    if ((flags.data[i] & (flagSPIN | flagDEAD)) == flagSPIN)
+    {
+      Spin(owner.data[i]->matrix, omega.data[i], dt);
+    }
+  }
+}
+
+
+//
+// ParticlePool::Expire
+//
+// Delete the particles whose time has expired
+//
+void ParticlePool::Expire()
+{
+  ASSERT(proto)
+
+  F32 lifeTime = proto->lifeTime;
+
+  if (lifeTime == 0.0F)
+  {
+    return;
+  }
+
+  for (U32 i = 0; i < count; i++)
+  {
+    if (Alive(i) && timer.data[i] >= lifeTime)
+    {
+      delete owner.data[i];
+    }
+  }
+}
+
+
+//
+// ParticlePool::Scatter
+//
+// Copy the streams back to the owning particles for the renderers
+//
+void ParticlePool::Scatter()
+{
+  for (U32 i = 0; i < count; i++)
+  {
+    if (Alive(i))
+    {
+      Particle *p = owner.data[i];
+
+      p->matrix.posit = posit.data[i];
+      p->veloc = veloc.data[i];
+      p->omega = omega.data[i];
+      p->timer = timer.data[i];
+    }
+  }
+}
+
+
+//
+// ParticlePool::Compact
+//
+// Remove all dead entries in one pass, keeping the order of the rest
+//
+void ParticlePool::Compact()
+{
+  if (dead)
+  {
+    U32 j = 0;
+
+    for (U32 i = 0; i < count; i++)
+    {
+      if (Alive(i))
+      {
+        if (i != j)
+        {
+          posit.data[j] = posit.data[i];
+          veloc.data[j] = veloc.data[i];
+          omega.data[j] = omega.data[i];
+          timer.data[j] = timer.data[i];
+          flags.data[j] = flags.data[i];
+          owner.data[j] = owner.data[i];
+          owner.data[j]->poolIndex = j;
+        }
+        j++;
+      }
+    }
+
+    count = j;
+    dead = 0;
+  }
+
+  if (!count && node.InUse())
+  {
+    ParticleSystem::DeletePool(this);
+  }
+}
+
+
 //
 // ParticleClass::ParticleClass
 //
@@ -28,6 +323,8 @@ ParticleClass::ParticleClass()
   makeUnderFog = FALSE;
   defaultRender = TRUE;
   priority = 1.0f;
+  pooled = TRUE;
+  pool.proto = this;
 }
 
 
@@ -106,6 +403,10 @@ void ParticleClass::Setup(FScope *fScope)
       case 0x0312FA29: // "NoDefaultRender"
         defaultRender = FALSE;
         break;
+
+      case 0x8E82E0EE: // "NoPool"
+        pooled = FALSE;
+        break;
     }
   }
   if (lifeTime <= 0.0f)
@@ -144,6 +445,18 @@ void ParticleClass::PostLoad()
   }
 }
 
+
+//
+// ParticleClass::SimulatePool
+//
+// Simulate all pooled particles of this class
+//
+void ParticleClass::SimulatePool(F32 dt)
+{
+  pool.Integrate(dt);
+  pool.Expire();
+}
+
 //
 // Particle::Particle
 //
@@ -175,9 +488,21 @@ Particle::Particle(
 	}
 
   stopped = FALSE;
+  reduced = FALSE;
+  value = 1.0F;
+  pooled = proto->pooled;
+  poolIndex = 0;
 
-	// Add this to the simulator list
-  ParticleSystem::AddSimulator(this);
+  if (pooled)
+  {
+    // Add this to the class pool
+    poolIndex = proto->pool.Add(this);
+  }
+  else
+  {
+	  // Add this to the simulator list
+    ParticleSystem::AddSimulator(this);
+  }
 
   // and death track system
   TrackSys::RegisterConstruction(dTrack);
@@ -200,8 +525,16 @@ Particle::~Particle()
   // Remove from death track system
   TrackSys::RegisterDestruction(dTrack);
 
-	// remove this from the simulator list
-  ParticleSystem::DeleteSimulator(this);
+  if (pooled)
+  {
+    // remove this from the class pool
+    proto->pool.Remove(poolIndex);
+  }
+  else
+  {
+	  // remove this from the simulator list
+    ParticleSystem::DeleteSimulator(this);
+  }
 }
 
 
@@ -212,20 +545,7 @@ Bool Particle::Simulate( F32 dt)
 	// advance the particle's life timer
 	timer += dt;
 
-  Quaternion q(matrix);
-  if (omega.x)
-  {
-    q *= Quaternion( omega.x * dt, Matrix::I.right);
-  }
-  if (omega.y)
-  {
-    q *= Quaternion( omega.y * dt, Matrix::I.up);
-  }
-  if (omega.z)
-  {
-    q *= Quaternion( omega.z * dt, Matrix::I.up);
-  }
-  matrix.Set( q);
+  Spin(matrix, omega, dt);
 
   matrix.posit += (veloc * dt);
 
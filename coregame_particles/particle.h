@@ -17,6 +17,7 @@
 // Includes
 //
 #include "dtrack.h"
+#include "array.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -29,6 +30,81 @@ class ParticleRenderClass;
 class FScope;
 
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// Class ParticlePool - structure of arrays simulation streams for one class
+//
+class ParticlePool
+{
+public:
+
+  enum
+  {
+    flagDEAD  = 0x0001,     // waiting for compaction
+    flagSPIN  = 0x0002,     // has angular velocity
+  };
+
+  // Active pool list node
+  NList<ParticlePool>::Node node;
+
+  // Owning class
+  ParticleClass *proto;
+
+  // Streams, one entry per particle
+  Array<Vector> posit;
+  Array<Vector> veloc;
+  Array<Vector> omega;
+  Array<F32> timer;
+  Array<U32> flags;
+  Array<Particle *> owner;
+
+  // Entries in use, and how many of those are dead
+  U32 count, dead;
+
+public:
+
+  ParticlePool();
+  ~ParticlePool();
+
+  // Free the streams
+  void Release();
+
+  // Add a particle, returns its index
+  U32 Add(Particle *p);
+
+  // Mark an entry as dead
+  void Remove(U32 index);
+
+  // Copy the owning particles' state into the streams
+  void Gather();
+
+  // Advance the timer, position and orientation of all live entries
+  void Integrate(F32 dt);
+
+  // Delete the particles whose time has expired
+  void Expire();
+
+  // Copy the streams back to the owning particles
+  void Scatter();
+
+  // Remove all dead entries in one pass
+  void Compact();
+
+  // Is this entry alive
+  Bool Alive(U32 index)
+  {
+    return (!(flags.data[index] & flagDEAD));
+  }
+
+private:
+
+  // Reallocate the streams
+  void Grow(U32 size);
+
+};
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 // Class ParticleClass
@@ -52,7 +128,11 @@ public:
 
   U32 showUnderFog : 1,
       makeUnderFog : 1,
-      defaultRender : 1;
+      defaultRender : 1,
+      pooled : 1;
+
+  // Simulation streams for pooled particles
+  ParticlePool pool;
 
 public:
 
@@ -75,6 +155,9 @@ public:
     F32 timer,
     void *data = NULL);
 
+  // simulate all pooled particles of this class
+  virtual void SimulatePool(F32 dt);
+
 	// apply all particle simulators
 	static void SimulateAll(F32 dt);
 
@@ -94,6 +177,9 @@ class ParticleRender;
 //
 // Class Particle - base simulator class
 //
+// Particles of a pooled class are simulated in bulk by their class, their
+// Simulate is never called
+//
 class Particle
 {
 public:
@@ -117,7 +203,15 @@ public:
   Vector length;
 	F32 timer;
 
-  U32 stopped : 1;
+  U32 stopped : 1,
+      pooled : 1,
+      reduced : 1;
+
+  // Value assigned by the particle budget
+  F32 value;
+
+  // Index into the class pool, if pooled
+  U32 poolIndex;
 
 public:
 
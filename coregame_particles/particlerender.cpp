@@ -25,6 +25,7 @@
 ParticleRenderClass::ParticleRenderClass()
 {
 	rate = 0.0f;
+  concurrent = FALSE;
 }
 
 
@@ -134,6 +135,14 @@ void ParticleRender::Simulate( F32 dt)
 }
 //----------------------------------------------------------------------------
 
+//
+// FlipState
+//
+void ParticleRender::FlipState()
+{
+}
+//----------------------------------------------------------------------------
+
 //
 // Render
 //
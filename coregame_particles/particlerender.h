@@ -45,6 +45,9 @@ public:
 
   F32 rate;
 
+  // renderers may be simulated on the worker thread
+  Bool concurrent;
+
 public:
 	// particle renderer class constructor
 	ParticleRenderClass();
@@ -105,6 +108,9 @@ public:
 	// simulate particle renderer
 	virtual void Simulate( F32 dt);
 
+  // make the state simulated on the worker thread visible to Render
+  virtual void FlipState();
+
 	// apply particle renderer
 	virtual void Render();
 
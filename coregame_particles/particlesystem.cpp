@@ -36,6 +36,8 @@
 #include "sight.h"
 #include "team.h"
 #include "vid_private.h"
+#include "perfstats.h"
+#include "system.h"
 
 // DEBUGGING
 #include "terrain.h"
@@ -91,6 +93,9 @@ namespace ParticleSystem
   // List of all active particle simulators
   NList<Particle> simulators(&Particle::node);
 
+  // List of all class pools with particles in them
+  NList<ParticlePool> pools(&ParticlePool::node);
+
   // List of all active renderers
   NList<ParticleRender> renderSim(&ParticleRender::node);
 
@@ -116,6 +121,461 @@ namespace ParticleSystem
   void CmdHandler(U32 pathCrc);
 
 
+  ///////////////////////////////////////////////////////////////////////////////
+  //
+  // NameSpace Budget - limits the number of simulators and renderers
+  //
+  // Particles are valued by priority, distance to the camera, fog and an
+  // estimate of their screen coverage.  When over budget the lowest valued
+  // ones are decimated, new ones below the same value are refused, and the
+  // lowest valued ones over the renderer budget are not drawn.
+  //
+  namespace Budget
+  {
+    // Number of value bins
+    const U32 BINS = 64;
+
+    // Value scale for particles under fog
+    const F32 FOG_SCALE = 0.25F;
+
+    // Extent to distance ratio at which a particle fills the view
+    const F32 COVERAGE_SCALE = 8.0F;
+
+    // Budget is recalculated above this fraction of the limits
+    const F32 ACTIVE_SCALE = 0.75F;
+
+    // Limits, zero for none
+    static VarInteger maxSimulators;
+    static VarInteger maxRenderers;
+
+    // New particles below this value are refused
+    static F32 refuseValue;
+
+    // Particles below this value are not rendered
+    static F32 reduceValue;
+
+    // Counters
+    static U32 refused;
+    static U32 decimated;
+    static U32 reduced;
+
+
+    //
+    // Initialise
+    //
+    void Init()
+    {
+      VarSys::CreateInteger("coregame.particle.budget.simulators", 4000, VarSys::DEFAULT, &maxSimulators)->SetIntegerRange(0, S32_MAX);
+      VarSys::CreateInteger("coregame.particle.budget.renderers", 6000, VarSys::DEFAULT, &maxRenderers)->SetIntegerRange(0, S32_MAX);
+
+      refuseValue = reduceValue = 0.0F;
+      refused = decimated = reduced = 0;
+    }
+
+
+    //
+    // Value of a particle, 0 to 1
+    //
+    F32 Value(const ParticleClass *p, const Vector &posit, const Vector &length)
+    {
+      // priority runs from 0 - very important to 2 - not important
+      F32 value = 1.0F - p->priority * 0.5F;
+
+      Vector p1 = posit + length;
+      if (!Visible(posit, p, &p1))
+      {
+        value *= FOG_SCALE;
+      }
+
+      const Camera &camera = Vid::CurCamera();
+
+      F32 dist = Max<F32>((posit - camera.WorldMatrix().posit).Magnitude(), 1.0F);
+
+      // nearer is better
+      value *= 1.0F - 0.5F * Min<F32>(dist / camera.FarPlane(), 1.0F);
+
+      // bigger on screen is better
+      value *= Min<F32>((length.Magnitude() + 1.0F) * COVERAGE_SCALE / dist, 1.0F);
+
+      return (value);
+    }
+
+
+    //
+    // Bin for a value
+    //
+    inline U32 Bin(F32 value)
+    {
+      return (Min<U32>(Utils::FtoL(value * F32(BINS)), BINS - 1));
+    }
+
+
+    //
+    // Lowest value that keeps the count at or below the limit
+    //
+    F32 Cutoff(const U32 *hist, U32 count, U32 limit)
+    {
+      if (!limit || count <= limit)
+      {
+        return (0.0F);
+      }
+
+      U32 total = 0;
+      for (U32 b = BINS; b--;)
+      {
+        total += hist[b];
+        if (total > limit)
+        {
+          return (F32(b + 1) / F32(BINS));
+        }
+      }
+      return (0.0F);
+    }
+
+
+    //
+    // Should a new particle be created
+    //
+    Bool Accept(const ParticleClass *p, const Vector &posit, const Vector &length)
+    {
+      if (refuseValue > 0.0F && p->priority > 0.0F && Value(p, posit, length) < refuseValue)
+      {
+        refused++;
+        return (FALSE);
+      }
+      return (TRUE);
+    }
+
+
+    //
+    // Score all particles and apply the limits
+    //
+    void Process()
+    {
+      U32 simCount = simulators.GetCount();
+      for (NList<ParticlePool>::Iterator p(&pools); *p; p++)
+      {
+        simCount += (*p)->count - (*p)->dead;
+      }
+      U32 renderCount = renderSim.GetCount() + renderInt.GetCount();
+
+      U32 simLimit = maxSimulators;
+      U32 renderLimit = maxRenderers;
+
+      PERF_COUNT("Particle sims", simCount, simLimit)
+      PERF_COUNT("Particle renders", renderCount, renderLimit)
+      PERF_COUNT("Particle refused", refused, 0)
+      PERF_COUNT("Particle decimated", decimated, 0)
+      PERF_COUNT("Particle reduced", reduced, 0)
+
+      refused = decimated = 0;
+
+      Bool active = 
+        (simLimit && F32(simCount) > F32(simLimit) * ACTIVE_SCALE) || 
+        (renderLimit && F32(renderCount) > F32(renderLimit) * ACTIVE_SCALE);
+
+      if (!active && !reduced)
+      {
+        refuseValue = reduceValue = 0.0F;
+        return;
+      }
+
+      // Value every particle
+      U32 simHist[BINS], renderHist[BINS];
+      Utils::Memset(simHist, 0, sizeof(simHist));
+      Utils::Memset(renderHist, 0, sizeof(renderHist));
+
+      NList<Particle>::Iterator i(&simulators);
+      NList<ParticlePool>::Iterator j(&pools);
+
+      for (!i; *i; i++)
+      {
+        Particle *particle = *i;
+
+        particle->value = particle->proto->priority > 0.0F ? Value(particle->proto, particle->matrix.posit, particle->length) : 1.0F;
+
+        U32 bin = Bin(particle->value);
+        simHist[bin]++;
+        renderHist[bin] += particle->renderList.GetCount();
+      }
+      for (!j; *j; j++)
+      {
+        ParticlePool *pool = *j;
+
+        for (U32 n = 0; n < pool->count; n++)
+        {
+          if (pool->Alive(n))
+          {
+            Particle *particle = pool->owner.data[n];
+
+            particle->value = pool->proto->priority > 0.0F ? Value(pool->proto, pool->posit.data[n], particle->length) : 1.0F;
+
+            U32 bin = Bin(particle->value);
+            simHist[bin]++;
+            renderHist[bin] += particle->renderList.GetCount();
+          }
+        }
+      }
+
+      refuseValue = active ? Cutoff(simHist, simCount, simLimit) : 0.0F;
+      reduceValue = active ? Cutoff(renderHist, renderCount, renderLimit) : 0.0F;
+
+      // Decimate and reduce
+      reduced = 0;
+
+      for (!i; *i;)
+      {
+        Particle *particle = i++;
+
+        if (particle->value < refuseValue)
+        {
+          decimated++;
+          delete particle;
+        }
+        else if ((particle->reduced = particle->value < reduceValue) != 0)
+        {
+          reduced++;
+        }
+      }
+      for (!j; *j; j++)
+      {
+        ParticlePool *pool = *j;
+
+        for (U32 n = 0; n < pool->count; n++)
+        {
+          if (pool->Alive(n))
+          {
+            Particle *particle = pool->owner.data[n];
+
+            if (particle->value < refuseValue)
+            {
+              decimated++;
+              delete particle;
+            }
+            else if ((particle->reduced = particle->value < reduceValue) != 0)
+            {
+              reduced++;
+            }
+          }
+        }
+      }
+    }
+  }
+
+
+
+  ///////////////////////////////////////////////////////////////////////////////
+  //
+  // NameSpace Worker - simulates concurrent renderers off the main thread
+  //
+  // Renderers are queued during Simulate and SimulateInt and the batch is
+  // started at the end of SimulateInt, so it runs while the main thread gets
+  // on with game logic and the display.  The renderers only write their back
+  // state, which is flipped to the front once the batch is waited for.
+  //
+  namespace Worker
+  {
+    // Queued renderer
+    struct Item
+    {
+      ParticleRender *render;
+      F32 dt;
+    };
+
+    // Use the worker thread
+    static VarInteger enabled;
+
+    // Worker thread
+    static System::Thread *thread;
+    static U32 threadId;
+    static Bool quit;
+
+    // Signalled when a batch is started and finished
+    static System::Event startEvent;
+    static System::Event doneEvent;
+
+    // Queued renderers
+    static Array<Item> items;
+    static U32 itemCount;
+
+    // Is a batch in flight
+    static Bool busy;
+
+
+    //
+    // Simulate all queued renderers
+    //
+    static void Run()
+    {
+      for (U32 i = 0; i < itemCount; i++)
+      {
+        if (items.data[i].render)
+        {
+          items.data[i].render->Simulate(items.data[i].dt);
+        }
+      }
+    }
+
+
+    //
+    // Thread procedure
+    //
+    static U32 STDCALL Process(void *)
+    {
+      for (;;)
+      {
+        startEvent.Wait();
+
+        if (quit)
+        {
+          break;
+        }
+
+        Run();
+
+        doneEvent.Signal();
+      }
+      return (0);
+    }
+
+
+    //
+    // Wait for the batch in flight and make its results visible
+    //
+    void Wait()
+    {
+      if (busy)
+      {
+        doneEvent.Wait();
+        busy = FALSE;
+
+        for (U32 i = 0; i < itemCount; i++)
+        {
+          if (items.data[i].render)
+          {
+            items.data[i].render->FlipState();
+          }
+        }
+        itemCount = 0;
+      }
+    }
+
+
+    //
+    // Finish all queued renderers
+    //
+    void Flush()
+    {
+      Wait();
+
+      if (itemCount)
+      {
+        Run();
+        itemCount = 0;
+      }
+    }
+
+
+    //
+    // Drop a renderer that is being deleted from the queue
+    //
+    void Cancel(ParticleRender *render)
+    {
+      // Only a batch in flight can be touching it
+      Wait();
+
+      for (U32 i = 0; i < itemCount; i++)
+      {
+        if (items.data[i].render == render)
+        {
+          items.data[i].render = NULL;
+        }
+      }
+    }
+
+
+    //
+    // Queue a renderer for the next batch
+    //
+    void Queue(ParticleRender *render, F32 dt)
+    {
+      Wait();
+
+      if (itemCount == items.count)
+      {
+        Array<Item> temp(Max<U32>(256, itemCount << 1));
+
+        if (itemCount)
+        {
+          Utils::Memcpy(temp.data, items.data, itemCount * sizeof(Item));
+        }
+        items.Swap(temp);
+      }
+
+      items.data[itemCount].render = render;
+      items.data[itemCount].dt = dt;
+      itemCount++;
+    }
+
+
+    //
+    // Start the queued batch
+    //
+    void Start()
+    {
+      if (busy || !itemCount)
+      {
+        return;
+      }
+
+      if (thread && enabled)
+      {
+        busy = TRUE;
+        startEvent.Signal();
+      }
+      else
+      {
+        Run();
+        itemCount = 0;
+      }
+    }
+
+
+    //
+    // Initialise
+    //
+    void Init()
+    {
+      VarSys::CreateInteger("coregame.particle.worker", TRUE, VarSys::DEFAULT, &enabled);
+
+      itemCount = 0;
+      busy = FALSE;
+      quit = FALSE;
+
+      thread = new System::Thread(Process, NULL);
+      threadId = thread->GetId();
+    }
+
+
+    //
+    // Shutdown
+    //
+    void Done()
+    {
+      Flush();
+
+      quit = TRUE;
+      startEvent.Signal();
+
+      // Waits for the thread to exit
+      delete thread;
+      thread = NULL;
+
+      items.Release();
+    }
+  }
+
+
   //
   // Initialise particle system
   //
@@ -136,6 +596,9 @@ namespace ParticleSystem
     VarSys::CreateInteger("coregame.particle.enabled", TRUE, VarSys::DEFAULT, &enableParticles);
     VarSys::CreateInteger("coregame.particle.draw", TRUE, VarSys::DEFAULT, &drawParticles);
 
+    Budget::Init();
+    Worker::Init();
+
     cineractiveMode = FALSE;
     fastModeElapsed = 0.0F;
 
@@ -150,6 +613,8 @@ namespace ParticleSystem
   {
     ASSERT(sysInit);
 
+    Worker::Done();
+
     // Dispose of derived classes
     derivedParticles.DisposeAll();
     derivedRenderers.DisposeAll();
@@ -172,6 +637,8 @@ namespace ParticleSystem
   {
     ASSERT(sysInit)
 
+    Worker::Flush();
+
 //    simulators.DisposeAll();
 //    renderSim.DisposeAll();
 //    renderInt.DisposeAll();
@@ -182,6 +649,21 @@ namespace ParticleSystem
       delete (i++);
     }
 
+    // Dispose of pooled particles
+    for (NList<ParticlePool>::Iterator p(&pools); *p;)
+    {
+      ParticlePool *pool = p++;
+
+      for (U32 n = 0; n < pool->count; n++)
+      {
+        if (pool->Alive(n))
+        {
+          delete pool->owner.data[n];
+        }
+      }
+      pool->Compact();
+    }
+
     // Dispose of renderers
     for (NList<ParticleRender>::Iterator j(&renderSim); *j;)
     {
@@ -501,7 +983,7 @@ namespace ParticleSystem
   {
     ASSERT(p);
 
-    if (enableParticles)
+    if (enableParticles && Budget::Accept(p, matrix.posit, length))
     {
       return (p->Build(matrix, veloc, omega, length, timer, data));
     }
@@ -570,6 +1052,44 @@ namespace ParticleSystem
   }
 
 
+  //
+  // Add a class pool to the active list
+  //
+  void AddPool(ParticlePool *p)
+  {
+    ASSERT(p);
+    pools.Append(p);
+  }
+
+
+  //
+  // Delete a class pool from the active list
+  //
+  void DeletePool(ParticlePool *p)
+  {
+    ASSERT(p);
+    pools.Unlink(p);
+  }
+
+
+  //
+  // Is the caller the renderer worker thread
+  //
+  Bool OnWorker()
+  {
+    return (Worker::thread && System::Thread::GetCurrentId() == Worker::threadId);
+  }
+
+
+  //
+  // Make sure the worker is done with a renderer before it is deleted
+  //
+  void CancelRenderer(ParticleRender *p)
+  {
+    Worker::Cancel(p);
+  }
+
+
   //
   // Add a renderer to the system
   //
@@ -611,9 +1131,18 @@ namespace ParticleSystem
   //
   void Simulate(F32 dt)
   {
+#ifdef DEVELOPMENT
+    U32 pooled = 0;
+    for (NList<ParticlePool>::Iterator c(&pools); *c; c++)
+    {
+      pooled += (*c)->count - (*c)->dead;
+    }
+#endif
+
     MSWRITEV(13, (0, 0, "Simulators: %6d", simulators.GetCount()));
     MSWRITEV(13, (1, 0, "Renderers : %6d", renderSim.GetCount() + renderInt.GetCount()));
-    MSWRITEV(13, (2, 0, "TOTAL     : %6d", simulators.GetCount()+renderSim.GetCount()+renderInt.GetCount()));
+    MSWRITEV(13, (2, 0, "TOTAL     : %6d", simulators.GetCount()+pooled+renderSim.GetCount()+renderInt.GetCount()));
+    MSWRITEV(13, (3, 0, "Pooled    : %6d [%d]", pooled, pools.GetCount()));
 
     if (cineractiveMode)
     {
@@ -633,6 +1162,9 @@ namespace ParticleSystem
       }
     }
 
+    // Apply the particle budget
+    Budget::Process();
+
     // Simulate all simulators
     for (NList<Particle>::Iterator i(&simulators); *i;)
     {
@@ -645,6 +1177,17 @@ namespace ParticleSystem
       }
     }
 
+    // Simulate all pooled particles, one class at a time
+    for (NList<ParticlePool>::Iterator p(&pools); *p;)
+    {
+      ParticlePool *pool = p++;
+
+      pool->Gather();
+      pool->proto->SimulatePool(dt);
+      pool->Scatter();
+      pool->Compact();
+    }
+
     // Simulate all renderers
     for (NList<ParticleRender>::Iterator j(&renderSim); *j;)
     {
@@ -653,7 +1196,14 @@ namespace ParticleSystem
       // Check the proto - very rare bug - can sometimes be null??
       if (render->proto)
       {
-        render->Simulate(dt);
+        if (render->proto->concurrent)
+        {
+          Worker::Queue(render, dt);
+        }
+        else
+        {
+          render->Simulate(dt);
+        }
       }
     }
   }
@@ -668,8 +1218,19 @@ namespace ParticleSystem
     for (NList<ParticleRender>::Iterator j(&renderInt); *j;)
     {
       ParticleRender * render = j++;
-      render->Simulate(dt);
+
+      if (render->proto->concurrent)
+      {
+        Worker::Queue(render, dt);
+      }
+      else
+      {
+        render->Simulate(dt);
+      }
     }
+
+    // Run the concurrent renderers while the main thread gets on with it
+    Worker::Start();
   }
 
   //
@@ -690,12 +1251,14 @@ namespace ParticleSystem
   //
   void Render(Camera &)
   {
+    Vid::Governor::SetLoad( Vid::Governor::stagePARTICLE, renderSim.GetCount() + renderInt.GetCount());
+
     if (drawParticles)
     {
       NList<ParticleRender>::Iterator i(&renderSim);
       while (ParticleRender * render = i++)
       {
-        if (!render->particle || !render->particle->proto || render->particle->proto->defaultRender)
+        if (!render->particle || !render->particle->proto || (render->particle->proto->defaultRender && !render->particle->reduced))
         {
           render->Render();
         }
@@ -703,12 +1266,15 @@ namespace ParticleSystem
       NList<ParticleRender>::Iterator ii(&renderInt);
       while (ParticleRender * render = ii++)
       {
-        if (!render->particle || !render->particle->proto || render->particle->proto->defaultRender)
+        if (!render->particle || !render->particle->proto || (render->particle->proto->defaultRender && !render->particle->reduced))
         {
           render->Render();
         }
       }
     }
+
+    // Start anything queued since the last SimulateInt
+    Worker::Start();
   }
 
 
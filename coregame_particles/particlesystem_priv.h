@@ -27,6 +27,7 @@
 // Forward declarations
 //
 class Particle;
+class ParticlePool;
 class ParticleRender;
 
 
@@ -43,12 +44,24 @@ namespace ParticleSystem
   // Delete a simulator from the system
   void DeleteSimulator(Particle *p);
 
+  // Add a class pool to the active list
+  void AddPool(ParticlePool *p);
+
+  // Delete a class pool from the active list
+  void DeletePool(ParticlePool *p);
+
   // Add a renderer to the system
   void AddRenderer(ParticleRender *p);
 
   // Delete a renderer from the system
   void DeleteRenderer(ParticleRender *p);
 
+  // Is the caller the renderer worker thread
+  Bool OnWorker();
+
+  // Make sure the worker is done with a renderer before it is deleted
+  void CancelRenderer(ParticleRender *p);
+
   // Read a D3D color value
   void GetColor(FScope *parent, const char * name, ColorF32 & value, ColorF32 dVal);
 
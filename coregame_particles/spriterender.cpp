@@ -21,6 +21,8 @@
 //
 SpriteRenderClass::SpriteRenderClass() : ParticleRenderClass()
 {
+  // simulation only touches the renderer and the class
+  concurrent = TRUE;
 }
 
 
@@ -79,6 +81,11 @@ SpriteRender::SpriteRender( SpriteRenderClass *p, Particle *particle, void *data
 
   colorAnim.Setup( lifeTime, &p->colorKeys, &p->data, p->data.animFlags);
   scaleAnim.Setup( lifeTime, &p->scaleKeys, &p->data, p->data.animFlags);
+
+  front = 0;
+  SaveState();
+  FlipState();
+  SaveState();
 }
 
 //
@@ -86,6 +93,8 @@ SpriteRender::SpriteRender( SpriteRenderClass *p, Particle *particle, void *data
 //
 SpriteRender::~SpriteRender()
 {
+  // make sure the worker is done with this
+  ParticleSystem::CancelRenderer(this);
 }
 
 
@@ -100,9 +109,10 @@ void SpriteRender::Render()
 	  SpriteRenderClass *pclass = (SpriteRenderClass *)proto;
 
     Matrix & m = particle->matrix;
+    const State & s = Front();
 
-    Vid::RenderSprite( TRUE, m.posit + pclass->data.offset, scaleAnim.Current().scale, 
-      texture, colorAnim.Current().color, pclass->data.blend, U16(pclass->data.sorting), 
+    Vid::RenderSprite( TRUE, m.posit + pclass->data.offset, s.scale, 
+      s.texture, s.color, pclass->data.blend, U16(pclass->data.sorting), 
       m.right.x != 0 || m.right.y != 0 ? m.right : m.front);
   }
 }
@@ -118,4 +128,34 @@ void SpriteRender::Simulate( F32 dt)
 
   colorAnim.Simulate( dt, pclass->data.animRate);
   scaleAnim.SetSlave( colorAnim.Current().frame);
+
+  SaveState();
+
+  if (!ParticleSystem::OnWorker())
+  {
+    // visible right away
+    FlipState();
+  }
+}
+
+
+//
+// SaveState
+//
+void SpriteRender::SaveState()
+{
+  State & s = state[front ^ 1];
+
+  s.texture = texture;
+  s.color = colorAnim.Current().color;
+  s.scale = scaleAnim.Current().scale;
+}
+
+
+//
+// FlipState
+//
+void SpriteRender::FlipState()
+{
+  front ^= 1;
 }
\ No newline at end of file
@@ -59,6 +59,26 @@ protected:
   KeyAnim<ColorKey> colorAnim;
   KeyAnim<ScaleKey> scaleAnim;
 
+  // Render state, double buffered so that Render never reads what the
+  // worker thread is writing
+  struct State
+  {
+    Bitmap * texture;
+    Color color;
+    F32 scale;
+  };
+  State state[2];
+  U32 front;
+
+  // Save the simulated state to the back buffer
+  void SaveState();
+
+  // The state to render
+  const State & Front() const
+  {
+    return state[front];
+  }
+
 public:
 	// sprite renderer constructor
 	SpriteRender(SpriteRenderClass *proto, Particle *particle, void *data = NULL);
@@ -72,6 +92,9 @@ public:
 	// Apply particle simulator
 	virtual void Simulate( F32 dt);
 
+  // Make the back buffer visible to Render
+  virtual void FlipState();
+
 };
 
 #endif
@@ -51,11 +51,12 @@ void WaterSpriteRender::Render()
   if (Visible() != clipOUTSIDE)
   {
 	  WaterSpriteRenderClass *pclass = (WaterSpriteRenderClass *)proto;
+    const State & s = Front();
 
     Terrain::RenderWaterSprite( 
-      particle->matrix.posit, scaleAnim.Current().scale, 
+      particle->matrix.posit, s.scale, 
       particle->matrix.front,
-      texture, colorAnim.Current().color, pclass->data.blend,
+      s.texture, s.color, pclass->data.blend,
       UVPair(0.0f,1.0f), UVPair(1.0f,1.0f), UVPair(1.0f,0.0f));
   }
 }
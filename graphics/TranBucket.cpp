@@ -63,6 +63,16 @@ Bool TranBucketMan::CompareRenderState( const PrimitiveDesc & other) const
 }
 //-----------------------------------------------------------------------------
 
+// back to front by z tag, then blend mode, texture and material
+//
+U64 TranBucketMan::SortKey( const Bucket & bucket) const
+{
+  return ((U64) (~bucket.tag) << 32)
+       | ((U64) ((bucket.flags >> RS_SRC_SHIFT) & 0xff) << 24)
+       | StateKey( bucket);
+}
+//----------------------------------------------------------------------------
+
 void TranBucketMan::Flush( Bool doDraw)  // = TRUE
 { 
   if (!doDraw)
@@ -74,79 +84,36 @@ void TranBucketMan::Flush( Bool doDraw)  // = TRUE
   Vid::SetZWriteState( FALSE);
   Bool alpha = Vid::SetAlphaState( TRUE);
 
-	// figure out how many buckets actually have vertices in them
-	// so that we don't have to look at any empty buckets
-
-	NList<Bucket>::Iterator li(&bucketList); 
-  Bucket * list[444];
-  S32 count = 0;
-  while (Bucket * bucket = li++)
+	// only the buckets that have vertices in them, farthest first
+  //
+  U32 count = BuildQueue();
+  if (count)
   {
-    if (bucket->vCount)
+    BucketCmd * cmd = SortQueue( count), * ce = cmd + count;
+    for ( ; cmd < ce; cmd++)
     {
-      list[count] = bucket;
-      count++;
-
-      ASSERT( count <= 444);
-    }
-#ifdef DOLASTBUCKET
-    if (bucket == lastUsedBucket)
-    {
-      break;
-    }
-#endif
-  }
+      Bucket * max = cmd->bucket;
 
-	// for each bucket that is not empty...
-	for (count--; count >= 0; count--)
-	{
-		Bucket *max = list[count];
-  
-		// find the bucket with the maximum z value
-    S32 i, current = count;
-		for (i = count - 1; i >= 0; i--)
-		{
-			if (list[i]->tag > max->tag)
-			{
-				max = list[i];
-        current = i;
-			}
-/*
-			else if (list[i]->tag == max->tag)
+      if (!Vid::caps.noTransort && !(max->flags & RS_NOSORT) && primitive.primitive_type != PT_LINELIST)
       {
-        if (list[i]->tag1 > max->tag1)
-        {
-	  			max = list[i];
-          current = i;
-        }
+        max->Sort();
       }
-*/
-		}
+      if ((max->flags & RS_DST_MASK) == RS_DST_ONE)
+      {
+        Vid::SetFogColorD3D( 0);
 
-    if (!Vid::caps.noTransort && !(max->flags & RS_NOSORT) && primitive.primitive_type != PT_LINELIST)
-    {
-      max->Sort();
-    }
-		// flush the bucket with the maximum z value
-    if ((max->flags & RS_DST_MASK) == RS_DST_ONE)
-    {
-      Vid::SetFogColorD3D( 0);
+  		  FlushBucket( *max);
 
-  		FlushBucket( *max);
+        Vid::SetFogColorD3D( Vid::renderState.fogColor);
+      }
+      else
+      {
+  		  FlushBucket( *max);
+      }
 
-      Vid::SetFogColorD3D( Vid::renderState.fogColor);
-    }
-    else
-    {
-  		FlushBucket( *max);
+      max->Reset();
     }
-
-    max->Reset();
-
-    // move end of list to current position 
-    //
-    list[current] = list[count];
-	}
+  }
 
 
   Vid::SetAlphaState( alpha);
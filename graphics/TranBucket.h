@@ -49,6 +49,7 @@ public:
 	virtual void SetPrimitiveDesc( PrimitiveDesc & primitive);
 	virtual void SetPrimitiveDesc( Bucket & bucket, PrimitiveDesc & primitive);
 	virtual Bool CompareRenderState( const PrimitiveDesc & prim) const;
+  virtual U64  SortKey( const Bucket & bucket) const;
 
   void TranBucketMan::SetMaxZ( F32 _maxZ)
   {
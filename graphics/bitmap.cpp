@@ -323,6 +323,11 @@ Bool Bitmap::Create(S32 width, S32 height, Bool translucent, S32 mips, U32 depth
   }
   else
   {
+    if (!Vid::ddx)
+    {
+      // device-less; no surfaces and Vid::Soft doesn't sample textures
+      return FALSE;
+    }
     InitPixFormat();
 
     ASSERT( pixForm);
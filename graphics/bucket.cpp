@@ -74,6 +74,9 @@ void BucketMan::ClearData()
   memSize = curSize = lastSize = 0;
   memBlock = curMem = lastMem = NULL;
 
+  queue.Release();
+  queueTemp.Release();
+
   bucketList.SetNodeMember( &Bucket::listNode);
 
   forceTranslucent = FALSE;
@@ -144,6 +147,9 @@ void BucketMan::DisposeAll()
 
 	bucketList.DisposeAll();
 
+  queue.Release();
+  queueTemp.Release();
+
 	currentBucket = NULL;
 	lastUsedBucket = NULL;
 	primitive.ClearData();
@@ -829,25 +835,125 @@ void BucketMan::FlushBucket( Bucket & bucket, Bool doDraw) // = TRUE)
 }
 //----------------------------------------------------------------------------
 
-void BucketMan::Flush( Bool doDraw) // = TRUE)
-{ 
+// texture and material part of a sort key; 24 bits
+// buckets sharing a state end up adjacent, the order between states doesn't matter
+//
+U32 BucketMan::StateKey( const Bucket & bucket)
+{
+  U32 tex = bucket.texture_count ? (U32) bucket.textureStages[0].texture : 0;
+  U32 mat = (U32) bucket.material;
+
+  return ((tex >> 4) * 0x9E3779B1 >> 20 << 12) | ((mat >> 4) * 0x9E3779B1 >> 20);
+}
+//----------------------------------------------------------------------------
+
+// opaque: blend mode, then texture and material
+//
+U64 BucketMan::SortKey( const Bucket & bucket) const
+{
+  return ((U64) (bucket.flags & (RS_BLEND_MASK | RS_ADD_MASK)) << 32)
+       | ((U64) bucket.primitive_type << 24)
+       | StateKey( bucket);
+}
+//----------------------------------------------------------------------------
+
+// collect the non-empty buckets with their sort keys
+//
+U32 BucketMan::BuildQueue()
+{
+  U32 count = bucketList.GetCount();
+  if (queue.count < count)
+  {
+    queue.Alloc( count + 32);
+    queueTemp.Alloc( count + 32);
+  }
+
+  count = 0;
 	NList<Bucket>::Iterator li(&bucketList); 
   while (Bucket * bucket = li++)
   {
     if (bucket->vCount)
     {
-/*
-      U32 alpha = Vid::renderState.status.alpha;
+      BucketCmd & cmd = queue[count++];
+      cmd.key    = SortKey( *bucket);
+      cmd.bucket = bucket;
+    }
+#ifdef DOLASTBUCKET
+    if (bucket == lastUsedBucket)
+    {
+      break;
+    }
+#endif
+  }
+  return count;
+}
+//----------------------------------------------------------------------------
+
+// stable lsd radix sort on the key, a byte at a time
+// bytes that are the same for every entry are skipped
+// returns the sorted array; either queue or queueTemp
+//
+BucketCmd * BucketMan::SortQueue( U32 count)
+{
+  BucketCmd * src = queue.data, * dst = queueTemp.data;
+
+  U32 shift;
+  for (shift = 0; shift < 64; shift += 8)
+  {
+    U32 hist[256];
+    Utils::Memset( hist, 0, sizeof( hist));
+
+    U32 i;
+    for (i = 0; i < count; i++)
+    {
+      hist[(U32) (src[i].key >> shift) & 0xff]++;
+    }
+    if (hist[(U32) (src[0].key >> shift) & 0xff] == count)
+    {
+      continue;
+    }
+
+    U32 sum = 0;
+    for (i = 0; i < 256; i++)
+    {
+      U32 c = hist[i];
+      hist[i] = sum;
+      sum += c;
+    }
+    for (i = 0; i < count; i++)
+    {
+      dst[hist[(U32) (src[i].key >> shift) & 0xff]++] = src[i];
+    }
+
+    BucketCmd * t = src; src = dst; dst = t;
+  }
+  return src;
+}
+//----------------------------------------------------------------------------
 
-      TextureStage & stage0 = bucket->textureStages[0];
-      if (stage0.texture && stage0.texture->IsTranslucent())
+void BucketMan::Flush( Bool doDraw) // = TRUE)
+{ 
+  if (doDraw)
+  {
+    // submit in state order
+    //
+    U32 count = BuildQueue();
+    if (count)
+    {
+      BucketCmd * cmd = SortQueue( count), * ce = cmd + count;
+      for ( ; cmd < ce; cmd++)
       {
-        Vid::SetAlphaState( TRUE);
+     		FlushBucket( *cmd->bucket);
       }
-*/
-   		FlushBucket( *bucket, doDraw);
+    }
+  }
 
-//      Vid::SetAlphaState( alpha);
+	NList<Bucket>::Iterator li(&bucketList); 
+  while (Bucket * bucket = li++)
+  {
+    if (bucket->vCount && !doDraw)
+    {
+   		FlushBucket( *bucket, doDraw);
     }
     bucket->Reset();
 
@@ -19,6 +19,14 @@
 #define DO_APPEND								0
 #define DO_PREPEND							1
 
+// one entry of the per flush submission queue
+//
+struct BucketCmd
+{
+  U64                     key;
+  Bucket *                bucket;
+};
+
 //////////////////////////////////////////////////////////////////////////////
 //
 // BucketMan declaration
@@ -42,6 +50,8 @@ protected:
 	U32											sizeofBucket;
 	F32											memRatio;
 
+  Array<BucketCmd>        queue, queueTemp;   // sorted submission order
+
 public:
   U32         						flushWhenFull : 1;
   
@@ -55,6 +65,11 @@ protected:
 
   void SetCurrentBucket( Bucket * bucket);
 
+  U32 BuildQueue();
+  BucketCmd * SortQueue( U32 count);
+
+  static U32 StateKey( const Bucket & bucket);
+
 public:
   BucketMan()
   {
@@ -72,6 +87,7 @@ public:
 	virtual void SetPrimitiveDesc( const PrimitiveDesc & primitive);
 	virtual void SetPrimitiveDesc( Bucket & bucket, const PrimitiveDesc & primitive);
 	virtual Bool CompareRenderState( const PrimitiveDesc & prim) const;
+  virtual U64  SortKey( const Bucket & bucket) const;
 
 	void Init( U32 _count, U32 _size, F32 _ratio, Bool _flushWhenFull);
 	void FlushBucket( Bucket & bucket, Bool doDraw = TRUE);
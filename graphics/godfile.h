@@ -75,6 +75,16 @@ public:
     memPtr += size;
   }
 
+  // Return a pointer to the next chunk of the mapped block and step past it
+  const U8 * LoadPtr(U32 size)
+  {
+    ASSERT(memPtr)
+    ASSERT(U32(memPtr - initPtr) + size <= this->size)
+    const U8 *ptr = memPtr;
+    memPtr += size;
+    return ptr;
+  }
+
   // Save a chunk of data
   void SaveData(const void *data, U32 size)
   {
@@ -175,6 +185,38 @@ namespace God
     }
   }
 
+  // Arrays of types saved as their memory image (no Load specialisation)
+  // are copied out of the mapped block in one go rather than per element
+  template <class T> void LoadArrayRaw(GodFile &god, Array<T> &array, U32 max = U32_MAX)
+  {
+    U32 count = god.LoadU32();
+    if (count > max)
+    {
+      ERR_FATAL(("GodFile::LoadArray: overflow %d ; max %d", count, max));
+    }
+
+    if (count)
+    {
+      array.Alloc(count);
+      memcpy(array.data, god.LoadPtr(count * sizeof(T)), count * sizeof(T));
+    }
+  }
+
+  template <class T> void LoadArray4Raw(GodFile &god, Array<T, 4> &array, U32 max = U32_MAX)
+  {
+    U32 count = god.LoadU32();
+    if (count > max)
+    {
+      ERR_FATAL(("GodFile::LoadArray: overflow %d ; max %d", count, max));
+    }
+
+    if (count)
+    {
+      array.Alloc(count);
+      memcpy(array.data, god.LoadPtr(count * sizeof(T)), count * sizeof(T));
+    }
+  }
+
   template <class T> void SaveArray4(GodFile &god, const Array<T, 4> &array)
   {
     Save(god, U32(array.count));
@@ -562,6 +562,10 @@ SOURCE=.\terrain.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\terrain_geo.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\terrain_lod.cpp
 # End Source File
 # Begin Source File
@@ -570,6 +574,10 @@ SOURCE=.\terrain_priv.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\terrain_pyramid.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\terrain_render_isometric.cpp
 # End Source File
 # Begin Source File
@@ -674,6 +682,10 @@ SOURCE=.\vid_enumdx.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\vid_governor.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\vid_heap.cpp
 # End Source File
 # Begin Source File
@@ -702,6 +714,10 @@ SOURCE=.\vid_settings.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\vid_soft.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\vid_sprite.cpp
 # End Source File
 # Begin Source File
@@ -375,6 +375,8 @@ namespace Vid
     {
       DisposeAll();
 
+      ReleaseModelBuffers();
+
       sun = NULL;
     }
     //----------------------------------------------------------------------------
@@ -659,7 +661,7 @@ namespace Vid
       }  
 
 #ifndef DODXLEANANDGRUMPY
-      if (renderState.status.dxTL)
+      if (renderState.status.dxTL && device)
       {
         // set lights
         NList<Obj>::Iterator i(&activeList);
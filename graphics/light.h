@@ -220,6 +220,11 @@ namespace Vid
       void PointLightModel(  const Vector & vert, ColorF32 & diff);
       void SpotLightModel(   const Vector & vert, ColorF32 & diff);
 
+      // batched diffuse; this light over 'count' verts 'stride' bytes apart
+      void PointLightModel(  const Vector * verts, U32 stride, const Vector * norms, U32 count, const ColorF32 & diffIn, ColorF32 * diff);
+      void SpotLightModel(   const Vector * verts, U32 stride, const Vector * norms, U32 count, const ColorF32 & diffIn, ColorF32 * diff);
+      void DirectLightModel( const Vector * norms, U32 count, const ColorF32 & diffIn, ColorF32 * diff);
+
       void Light( Color * lightvals, const Vector * norms, U32 count);
 
     #ifndef DODXLEANANDGRUMPY
@@ -71,6 +71,10 @@ namespace Vid
     void SetupLightsModel();
     void LightModel(  const Vector & vert, const Vector & norm, const ColorF32 diffIn, const Material & material, ColorF32 & diff, ColorF32 &spec);
 
+    // light 'count' verts 'stride' bytes apart; 'diff' and 'spec' return per vert results
+    void LightModel(  const Vector * verts, U32 stride, const Vector * norms, U32 count, const ColorF32 & diffIn, const Material & material, const ColorF32 & diffInit, ColorF32 *& diff, ColorF32 *& spec);
+    void ReleaseModelBuffers();
+
     void SetupLightsModelQuick();
     void LightModelQuick( const Vector & vert, ColorF32 & diff);
 
@@ -8,6 +8,7 @@
 //
 
 #include "vid_public.h"
+#include "vid_cmd_var.h"
 #include "light_priv.h"
 #include "mesh.h"
 #include "perfstats.h"
@@ -118,6 +119,210 @@ namespace Vid
     }
     //----------------------------------------------------------------------------
 
+    // per vert results for the batched LightModel
+    //
+    static Array<ColorF32> diffBuffer;
+    static Array<ColorF32> specBuffer;
+
+    void ReleaseModelBuffers()
+    {
+      diffBuffer.Release();
+      specBuffer.Release();
+    }
+
+    void LightModel( const Vector * verts, U32 stride, const Vector * norms, U32 count, const ColorF32 & diffIn, const Material & material, const ColorF32 & diffInit, ColorF32 *& diff, ColorF32 *& spec)
+    {
+      if (diffBuffer.count < count)
+      {
+        diffBuffer.Alloc( count);
+        specBuffer.Alloc( count);
+      }
+      diff = diffBuffer.data;
+      spec = specBuffer.data;
+
+      U32 i;
+      for (i = 0; i < count; i++)
+      {
+        diff[i] = diffInit;
+      }
+
+      Bool batch = *Var::lightBatch;
+    #ifdef DOSPECULAR
+      batch = batch && !material.GetStatus().specular;
+    #endif
+
+      if (!batch)
+      {
+        // reference path: one vert at a time
+        const U8 * v = (const U8 *) verts;
+        for (i = 0; i < count; i++, v += stride)
+        {
+          LightModel( *((const Vector *) v), norms[i], diffIn, material, diff[i], spec[i]);
+        }
+        return;
+      }
+
+      PERF_X_S( "light");
+
+      for (i = 0; i < count; i++)
+      {
+        spec[i].Set( 0, 0, 0);
+      }
+
+      // each light runs over the whole batch with its own setup held constant
+	    NList<Obj>::Iterator li(&activeList); 
+	    while (Obj * light = li++)
+	    {
+        switch (light->GetType())
+        {
+        case lightPOINT:
+          light->PointLightModel( verts, stride, norms, count, diffIn, diff);
+          break;
+        case lightSPOT:
+          light->SpotLightModel(  verts, stride, norms, count, diffIn, diff);
+          break;
+        case lightDIRECTION:
+          light->DirectLightModel( norms, count, diffIn, diff);
+          break;
+        }
+      }
+      PERF_X_E( "light");
+    }
+    //----------------------------------------------------------------------------
+
+    void Obj::PointLightModel( const Vector * verts, U32 stride, const Vector * norms, U32 count, const ColorF32 & diffIn, ColorF32 * diff)
+    {
+      F32 range = d3d.dvRange, range2 = range * range;
+      F32 a0 = d3d.dvAttenuation0, a1 = d3d.dvAttenuation1, a2 = d3d.dvAttenuation2;
+      F32 dr = d3d.dcvDiffuse.r * diffIn.r;
+      F32 dg = d3d.dcvDiffuse.g * diffIn.g;
+      F32 db = d3d.dcvDiffuse.b * diffIn.b;
+
+      const U8 * v = (const U8 *) verts;
+      for (const Vector * ne = norms + count; norms < ne; norms++, diff++, v += stride)
+      {
+        const Vector & vert = *((const Vector *) v);
+
+        F32 dx = position.x - vert.x;
+        F32 dy = position.y - vert.y;
+        F32 dz = position.z - vert.z;
+        F32 dist2 = dx * dx + dy * dy + dz * dz;
+
+        // out of range
+        if (dist2 > range2)
+        {
+          continue;
+        }
+        F32 dist = (F32) sqrt( dist2);
+        if (dist == 0.0f)
+        {
+          dist = F32_EPSILON;
+        }
+        F32 invdist = 1.0f / dist;
+
+        dist = (range - dist) * invRange;
+        F32 a = a0 + dist * a1 + (dist * dist) * a2;
+        if (a <= 0.0f)
+        {
+          continue;
+        }
+
+        F32 d = (norms->x * dx + norms->y * dy + norms->z * dz) * invdist;
+        if (d > 0.0f)
+        {
+          d *= a;
+          diff->r += dr * d;
+          diff->g += dg * d;
+          diff->b += db * d;
+        }
+      }
+    }
+    //----------------------------------------------------------------------------
+
+    void Obj::SpotLightModel( const Vector * verts, U32 stride, const Vector * norms, U32 count, const ColorF32 & diffIn, ColorF32 * diff)
+    {
+      F32 range = d3d.dvRange, range2 = range * range;
+      F32 a0 = d3d.dvAttenuation0, a1 = d3d.dvAttenuation1, a2 = d3d.dvAttenuation2;
+      F32 dr = d3d.dcvDiffuse.r * diffIn.r;
+      F32 dg = d3d.dcvDiffuse.g * diffIn.g;
+      F32 db = d3d.dcvDiffuse.b * diffIn.b;
+
+      const U8 * v = (const U8 *) verts;
+      for (const Vector * ne = norms + count; norms < ne; norms++, diff++, v += stride)
+      {
+        const Vector & vert = *((const Vector *) v);
+
+        F32 dx = position.x - vert.x;
+        F32 dy = position.y - vert.y;
+        F32 dz = position.z - vert.z;
+        F32 dist2 = dx * dx + dy * dy + dz * dz;
+
+        // out of range
+        if (dist2 > range2)
+        {
+          continue;
+        }
+        F32 dist = (F32) sqrt( dist2);
+        if (dist == 0.0f)
+        {
+          dist = F32_EPSILON;
+        }
+        F32 invdist = 1.0f / dist;
+
+        dist = (range - dist) * invRange;
+        F32 a = a0 + dist * a1 + (dist * dist) * a2;
+        if (a <= 0.0f)
+        {
+          continue;
+        }
+
+        dx *= invdist;
+        dy *= invdist;
+        dz *= invdist;
+
+        // outside the outer cone
+        F32 cos_dir = dx * direction.x + dy * direction.y + dz * direction.z;
+        if (cos_dir <= cosPhi)
+        {
+          continue;
+        }
+
+        F32 d = norms->x * dx + norms->y * dy + norms->z * dz;
+        if (d > 0.0f)
+        {
+          // between inner and outer cone the light falls off linearly
+          if (cos_dir <= cosTheta)
+          {
+            d *= (cos_dir - cosPhi) * invAngle;
+          }
+          d *= a;
+          diff->r += dr * d;
+          diff->g += dg * d;
+          diff->b += db * d;
+        }
+      }
+    }
+    //----------------------------------------------------------------------------
+
+    void Obj::DirectLightModel( const Vector * norms, U32 count, const ColorF32 & diffIn, ColorF32 * diff)
+    {
+      F32 dr = d3d.dcvDiffuse.r * diffIn.r;
+      F32 dg = d3d.dcvDiffuse.g * diffIn.g;
+      F32 db = d3d.dcvDiffuse.b * diffIn.b;
+
+      for (const Vector * ne = norms + count; norms < ne; norms++, diff++)
+      {
+        F32 d = norms->Dot( direction);
+        if (d > 0.0f)
+        {
+          diff->r += dr * d;
+          diff->g += dg * d;
+          diff->b += db * d;
+        }
+      }
+    }
+    //----------------------------------------------------------------------------
+
     void Obj::PointLightModel( const Vector & vert, const Vector & norm, const ColorF32 & diffIn, const Material & material, ColorF32 & diff, ColorF32 & spec)
     {
       spec;
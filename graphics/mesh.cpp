@@ -162,6 +162,9 @@ void MeshRoot::ClearData()
 
 MeshRoot::~MeshRoot()
 {
+  ClearInstance( this);
+  ClearShadowCache( this);
+
   // check if its already been removed from the manager tree
   if (treeNode.InUse())
   {  
@@ -269,6 +272,8 @@ void MeshRoot::SetWorldRecurseRender( const Matrix &world, FamilyState *stateArr
 
 void MeshRoot::Setup()
 {
+  ClearInstance( this);
+
   useMrm = mrm ? TRUE : FALSE;
 
   SetupRenderProc();
@@ -240,6 +240,7 @@ public:
   protected:
     static MeshRoot  *FindExists( const char *meshName);
     static Bool       SetupRoot( MeshRoot &root, const char *rootName = NULL);
+    static MeshRoot  *LoadRoot( GodFile &god, const char *rootName);
 
     static void CmdInit();
     static void CmdDone();
@@ -259,8 +260,15 @@ public:
 
     static void      MakeName( BuffString &buff, const char *meshName, F32 scale = 1.0f); 
     static MeshRoot *Find( const char *meshName); 
+
+    // group ents by root, mrm state and team color for shared vertex streams
+    static void SortInstances( MeshEnt ** list, U32 count);
+    static void InstancesDone();
+
+    // time the ent render pass with and without shared streams
+    static void BenchInstances( U32 frames);
     static MeshRoot *FindRead( const char *meshName, const char *fileName = NULL); 
-    static MeshRoot *FindRead( const char *meshName, F32 scale, Bool mrmGen, const char *fileName = NULL);
+    static MeshRoot *FindRead( const char *meshName, F32 scale, Bool mrmGen, const char *fileName = NULL, U32 cacheKey = 0);
     static AnimList *ReadAnimCycle( const char *fileName, MeshRoot &mesh, const char *cycleName);
 
     // apply scale to name
@@ -269,6 +277,9 @@ public:
     // load name raw
     static MeshRoot *FindLoad( const char *godFileName); 
 
+    // load a cached xsi import if its key matches
+    static MeshRoot *FindCache( const char *meshName, const char *fileName, U32 cacheKey); 
+
     // construction functions that can return NULL
     // can also use MeshEnt contructors directly
     static MeshEnt *Create( const MeshRoot *mesh);
@@ -276,12 +287,12 @@ public:
 
     static void RenderList();
     static void SimulateList( F32 dt);
-    static void UpdateMRMFactor();
     static MeshEnt* PickAtScreenPos(S32 x, S32 y, MeshObj **child = NULL);
 
     // restore all meshes to max vertex count
     static void FullResList();
     static void SetupPerf();
+    static void SetupShadowPerf( F32 perf);
 
     static void SetupRenderProcList();
     static MeshRoot * MakeMesh( U32 vCount, U32 nCount, U32 uvCount, U32 fCount, Bitmap * texture);
@@ -443,6 +454,11 @@ protected:
   void SetupPlanes();
   void SetupPlane( U32 i);
   void SetupRenderProc();
+  static void ClearInstance( const MeshRoot * root = NULL);   // drop shared vertex streams
+  static void InstanceStats( U32 & builds, U32 & shared);     // streams built and reused since the last call
+  static void ClearShadowCache( const MeshRoot * root = NULL);  // drop shared shadow textures
+  static Bool ShadowCacheValid( S32 slot, U32 stamp);
+  static void ReleaseShadowCache( S32 slot, U32 stamp);
   Bool SetupStates( const FamilyState *_states, U32 count, Matrix *mats = NULL);
   Bool SetupStates( const Array<AnimKey> _states);
   Bool SetupAnimCycle( AnimList &animList, const char *cycleName = DEFCYCLENAME);
@@ -535,6 +551,10 @@ protected:
     dst.uv = src.uv;
   }
 
+  // transform verts[0..vCount) by already setup tranys
+  //
+  void SetVerts( const Matrix * tranys, Vector * verts, U32 vCount, Bool doMultiWeight) const;
+
   void SetVertsView(  const Array<FamilyState> & stateArray, Matrix * tranys, Vector * verts, U32 vCount, Bool doMutiWeight) const;
   void SetVertsWorld( const Array<FamilyState> & stateArray, Matrix * tranys, Vector * verts, U32 vCount, Bool doMutiWeight) const;
   void SetVertsWorld( const Array<FamilyState> & stateArray, Vector * verts, U32 vCount, Bool doMutiWeight) const;
@@ -661,6 +681,7 @@ public:
 
   // auto shadow texture generation
   void RenderShadowTexture( ShadowInfo & si, const Matrix ** lightA, U32 lCount, Array<FaceGroup> & _buckys, U32 vCount, const Array<FamilyState> & stateArray, U32 _controlFlags, Color color = 0x00000000, U32 blend = RS_BLEND_DEF);
+  Bool RenderShadowTextureCache( ShadowInfo & si, S32 & slot, U32 & stamp, Array<FaceGroup> & _buckys, U32 vCount, const Array<FamilyState> & stateArray, U32 _controlFlags, Color color = 0x00000000, U32 blend = RS_BLEND_DEF);
   void RenderShadowTextureGeneric( Color color = 0xffffffff, U32 blend = RS_BLEND_DEF, U32 jitter = 8, Bool doBuild = FALSE);
   void RenderShadowVerts( const Vector & vect, Area<F32> & size, U32 type, Vector * vA, U32 vCount, const Array<FamilyState> & stateArray, U32 _controlFlags, Color color = 0x00000000, U32 blend = RS_BLEND_DEF);
   void RenderShadowTex( Bitmap & dstT, Area<F32> & size, const Vector * vA, U32 lCount, U32 vCount, const Color * cA, Array<FaceGroup> & _buckys, U32 blend = RS_BLEND_DEF, U32 jitter = 0, Bool fitOneWay = FALSE);
@@ -710,6 +731,7 @@ public:
 
   Bool Save( const char *fileName);
   Bool SaveScale( const char *fileName);    // append scale to name
+  Bool SaveCache( U32 cacheKey);            // cache an xsi import
   Bool Load( const char *fileName);
   Bool Save(GodFile *godFile);
   Bool Load(GodFile *godFile);
@@ -22,6 +22,42 @@
 #include "statistics.h"
 #include "bucket_inline.h"
 #include "terrain.h"
+#include "main.h"
+#include "meshent.h"
+//----------------------------------------------------------------------------
+
+// verts that share a single state are transformed in runs with one matrix;
+// multi-weighted verts go one at a time
+//
+void MeshRoot::SetVerts( const Matrix * tranys, Vector * verts, U32 vCount, Bool doMultiWeight) const
+{
+  const VertIndex * vi = vertToState.data;
+  const Vector * src = vertices.data;
+
+  U32 i = 0;
+  while (i < vCount)
+  {
+    if (doMultiWeight && vi[i].count > 1)
+    {
+      SetVert( verts[i], src[i], tranys, vi[i], TRUE);
+      i++;
+      continue;
+    }
+
+    // find the end of the run
+    U32 index = vi[i].index[0], e;
+    for (e = i + 1; e < vCount; e++)
+    {
+      if (vi[e].index[0] != index || (doMultiWeight && vi[e].count > 1))
+      {
+        break;
+      }
+    }
+
+    tranys[index].Transform( verts + i, src + i, e - i);
+    i = e;
+  }
+}
 //----------------------------------------------------------------------------
 
 void MeshRoot::SetMatricesView( const Array<FamilyState> & stateArray, Matrix *tranys) const
@@ -74,11 +110,7 @@ void MeshRoot::SetVertsView( const Array<FamilyState> & stateArray, Matrix * tra
   SetMatricesView( stateArray, tranys);
 
   // transform verts to view space
-  U32 i;
-  for (i = 0; i < vCount; i++)
-  {
-    SetVert( tranys, i, verts[i], doMultiWeight);
-  }
+  SetVerts( tranys, verts, vCount, doMultiWeight);
 }
 //----------------------------------------------------------------------------
 
@@ -87,11 +119,7 @@ void MeshRoot::SetVertsWorld( const Array<FamilyState> & stateArray, Matrix * tr
   SetMatricesWorld( stateArray, tranys);
 
   // transform verts to world space
-  U32 i;
-  for (i = 0; i < vCount; i++)
-  {
-    SetVert( tranys, i, verts[i], doMultiWeight);
-  }
+  SetVerts( tranys, verts, vCount, doMultiWeight);
 }
 //----------------------------------------------------------------------------
 
@@ -102,11 +130,7 @@ void MeshRoot::SetVertsWorld( const Array<FamilyState> & stateArray, Vector * ve
   SetMatricesWorld( stateArray, tranys);
 
   // transform verts to world space
-  U32 i;
-  for (i = 0; i < vCount; i++)
-  {
-    SetVert( tranys, i, verts[i], doMultiWeight);
-  }
+  SetVerts( tranys, verts, vCount, doMultiWeight);
 }
 //----------------------------------------------------------------------------
 
@@ -127,50 +151,190 @@ void MeshRoot::SetVertsIdentity( const Array<FamilyState> & stateArray, Vector *
     tranys->posit.ClearData();
 
     // transform verts to world space
-    VertIndex * vi = vertToState.data;
-    Vector * v, * e = verts + vCount, * src = vertices.data;
-    for (v = verts; v < e; v++, vi++, src++)
-    {
-	    // set a single vert with multi-weighting
-	    
-	    // get the vertex in local coordinates
-      // transform by the zeroth matrix
-      //
-      U32 index = vi->index[0];
- 			tranys[index].Transform( *v, *src);
+    SetVerts( tranys, verts, vCount, doMultiWeight);
+  }
+  else
+  {
+    stateArray[0].WorldMatrix().Rotate( verts, vertices.data, vCount);
+  }
+}
+//----------------------------------------------------------------------------
 
-	    // if we are doing multiple weights
-      //
-      if (doMultiWeight && (vi->count > 1))
-	    {
-		    // scale by zeroth weight
-		    *v *= vi->weight[0];
+// runs of ents with the same root, mrm state and team color share the
+// per bucky vertex streams; only transform and lighting are done per ent
+//
+namespace Instance
+{
+  struct Vert
+  {
+    U16 vert, norm, uv;
+    U16 twin;                       // earlier stream vert with the same vert and norm
+  };
 
-		    // for each subsequent weight...
-		    for (U32 j = 1; j < vi->count; j++)
-		    {
-			    // transform by the Jth matrix
-			    Vector vertJ;
+  static const MeshRoot * root = NULL;
+  static U32              vertCount;
+  static Color            color;
 
-          U32 index = vi->index[j];
- 		    	tranys[index].Transform( vertJ, *src);
+  static Array<Vert>      verts;    // unique verts per bucky
+  static Array<Color>     colors;   // vertex colors modulated by the team color
+  static Array<U16>       index;    // 3 stream verts per face
+  static Array<U16>       remap;    // stream vert to bucket vert
+  static Array<U16>       vmap;
 
-          // scale by Jth weight
-			    vertJ *= vi->weight[j];
+  static U32              vertStart[MAXBUCKYS];
+  static U32              vertCounts[MAXBUCKYS];
+  static U32              indexStart[MAXBUCKYS];
 
-			    // accumulate value
-			    *v += vertJ;
-		    }
-	    }
+  static U32              builds;   // streams built since the last InstanceStats
+  static U32              shared;   // ents that reused the current streams
+
+  template <class T> void Reserve( Array<T> & array, U32 count)
+  {
+    if (array.count < count)
+    {
+      array.Alloc( count);
     }
   }
-  else
+
+  void Clear( const MeshRoot * _root)
   {
-    stateArray[0].WorldMatrix().Rotate( verts, vertices.data, vCount);
+    if (!_root || _root == root)
+    {
+      root = NULL;
+    }
+    if (!_root)
+    {
+      verts.Release();
+      colors.Release();
+      index.Release();
+      remap.Release();
+      vmap.Release();
+    }
+  }
+
+  // returns TRUE if the streams are valid for these ents
+  //
+  Bool Setup( const MeshRoot & _root, const Array<FaceGroup> & buckys, U32 _vertCount, Color _color)
+  {
+    if (!*Vid::Var::doInstance)
+    {
+      return FALSE;
+    }
+
+    // the team color only goes into the stream with vertex colors
+    _color.a = 255;
+    if (!_root.colors.count)
+    {
+      _color = 0xffffffff;
+    }
+
+    if (root == &_root && vertCount == _vertCount && U32(color) == U32(_color))
+    {
+      shared++;
+      return TRUE;
+    }
+    builds++;
+
+    root      = &_root;
+    vertCount = _vertCount;
+    color     = _color;
+
+    U32 total = 0, maxCount = 0;
+    const FaceGroup * b, * be = buckys.data + buckys.count;
+    for (b = buckys.data; b < be; b++)
+    {
+      total += b->faceCount * 3;
+    }
+    Reserve( verts, total);
+    Reserve( index, total);
+    Reserve( vmap, root->vertices.count);
+
+    U32 vc = 0, ic = 0;
+    for (b = buckys.data; b < be; b++)
+    {
+      U32 bi = b - buckys.data;
+
+      vertStart[bi]  = vc;
+      indexStart[bi] = ic;
+
+      memset( vmap.data, 0xff, sizeof(U16) * root->vertices.count);
+
+      Vert * v0 = verts.data + vc;
+      U16 count = 0;
+
+      const FaceObj * f, * fe = b->faces.data + b->faceCount;
+      for (f = b->faces.data; f < fe; f++)
+      {
+        for (U32 j = 0; j < 3; j++)
+        {
+          U16 k = vmap[f->verts[j]];
+
+          if (k != 0xffff && v0[k].norm == f->norms[j] && v0[k].uv == f->uvs[j])
+          {
+            index[ic++] = k;
+            continue;
+          }
+
+          Vert & v = v0[count];
+          v.vert = f->verts[j];
+          v.norm = f->norms[j];
+          v.uv   = f->uvs[j];
+          v.twin = 0xffff;
+
+          if (k != 0xffff && v0[k].norm == f->norms[j])
+          {
+            v.twin = k;
+          }
+          else
+          {
+            vmap[v.vert] = count;
+          }
+          index[ic++] = count++;
+        }
+      }
+      vertCounts[bi] = count;
+      vc += count;
+
+      if (count > maxCount)
+      {
+        maxCount = count;
+      }
+    }
+    Reserve( remap, maxCount);
+
+    if (root->colors.count)
+    {
+      Reserve( colors, vc);
+
+      ColorF32 base( color);
+      for (U32 i = 0; i < vc; i++)
+      {
+        colors[i].Modulate( root->colors[verts[i].vert], base.r, base.g, base.b);
+      }
+    }
+
+    return TRUE;
   }
 }
 //----------------------------------------------------------------------------
 
+void MeshRoot::ClearInstance( const MeshRoot * root) // = NULL
+{
+  Instance::Clear( root);
+}
+//----------------------------------------------------------------------------
+
+// streams built and reused since the last call
+//
+void MeshRoot::InstanceStats( U32 & builds, U32 & shared)
+{
+  builds = Instance::builds;
+  shared = Instance::shared;
+
+  Instance::builds = Instance::shared = 0;
+}
+//----------------------------------------------------------------------------
+
 void MeshRoot::RenderLightAnimVtl( Array<FaceGroup> & _buckys, U32 vCount, const Array<FamilyState> & stateArray, Color baseColor, U32 clipFlags, U32 _controlFlags)
 {
   ASSERT( _buckys.count <= MAXBUCKYS);
@@ -184,6 +348,10 @@ void MeshRoot::RenderLightAnimVtl( Array<FaceGroup> & _buckys, U32 vCount, const
   U16 * iv, * in, * iu;
   U32 heapSize = Vid::Heap::ReqMesh( &verts, vCount, &iv, vertices.count, &in, normals.count, &iu, uvs.count);
 
+  // shared vertex streams for runs of like ents
+  //
+  Bool instance = Instance::Setup( *this, _buckys, vCount, baseColor);
+
   // set up transform matrices and transform verts to view space
   //
   Matrix tranys[MAXMESHPERGROUP];
@@ -241,116 +409,204 @@ void MeshRoot::RenderLightAnimVtl( Array<FaceGroup> & _buckys, U32 vCount, const
     );
     bucky.diffInitC  = (U32) Utils::FtoL(bucky.diff.a * F32(baseColor.a));
 
-    // clear indexers
-    //
-/*
-    memset( iv, 0xff, sizeof(U16) * bucky.vertices.count);
-    memset( in, 0xfe, sizeof(U16) * bucky.vertices.count);
-    memset( iu, 0xfd, sizeof(U16) * bucky.vertices.count);
-*/
-    memset( iv, 0xff, sizeof(U16) * vertices.count);
-    memset( in, 0xfe, sizeof(U16) * normals.count);
-    memset( iu, 0xfd, sizeof(U16) * uvs.count);
-
-    // for all the faces in this group
-    //
-    FaceObj * f, * fe = bucky.faces.data + bucky.faceCount;
-    for (f = bucky.faces.data; f < fe; f++)
+    if (instance)
     {
-      FaceObj & face = *f;
-      ASSERT( face.verts[0] < vCount && face.verts[1] < vCount && face.verts[2] < vCount);
-
-      // backcull
+      // shared stream for this bucky
       //
-      if (!(bucky.flags0 & RS_2SIDED))
-      {
-        Plane plane;
-        plane.Set( verts[face.verts[0]], verts[face.verts[2]], verts[face.verts[1]]);
-        if (Vid::BackCull( plane.Dot( verts[face.verts[0]])))
-        {
-          continue;
-        }
-      }
+      U32 bi = b - _buckys.data;
+      Instance::Vert * sv0 = Instance::verts.data + Instance::vertStart[bi];
+      U16 * si    = Instance::index.data + Instance::indexStart[bi];
+      U16 * remap = Instance::remap.data;
+      memset( remap, 0xff, sizeof(U16) * Instance::vertCounts[bi]);
 
-      // light, project...
-      //
-      for (U32 j = 0; j < 3; j++)
+      FaceObj * f, * fe = bucky.faces.data + bucky.faceCount;
+      for (f = bucky.faces.data; f < fe; f++, si += 3)
       {
-        U16 ivj = face.verts[j];
-	      U16 inj = face.norms[j];
-	      U16 iuj = face.uvs[j];
-
-        ASSERT( ivj < vCount && inj < normals.count && iuj < uvs.count);
+        FaceObj & face = *f;
 
-        if (iv[ivj] != in[inj])
+        // backcull
+        //
+        if (!(bucky.flags0 & RS_2SIDED))
         {
-          // new vert
-          //
-          VertexTL & dv = bucky.CurrVertexTL();
-          Vector & sv = verts[ivj];
+          Plane plane;
+          plane.Set( verts[face.verts[0]], verts[face.verts[2]], verts[face.verts[1]]);
+          if (Vid::BackCull( plane.Dot( verts[face.verts[0]])))
+          {
+            continue;
+          }
+        }
 
-          dv.uv = uvs[iuj];
-          if (hasTread)
+        // light, project...
+        //
+        for (U32 j = 0; j < 3; j++)
+        {
+          U16 s = si[j];
+          if (remap[s] != 0xffff)
           {
-            dv.uv.v += vOffsets[vertToState[ivj].index[0]];
+            // same old vert
+            //
+            bucky.SetIndex( remap[s]);
+            continue;
           }
+          Instance::Vert & vert = sv0[s];
 
-          Vector norm;
-          tranys[vertToState[ivj].index[0]].Rotate( norm, normals[inj]);
+          VertexTL & dv = bucky.CurrVertexTL();
 
-          if (colors.count)
+          if (vert.twin != 0xffff && remap[vert.twin] != 0xffff)
           {
-            Color c;
-            c.Modulate( colors[ivj], base.r, base.g, base.b);
-            bucky.LightCamInline( dv, sv, norm, c); 
+            // old vert with new uv
+            //
+            dv = bucky.GetVertexTL( remap[vert.twin]);
           }
           else
           {
-            bucky.LightCamInline( dv, sv, norm, baseColor); 
-          }
+            // new vert
+            //
+            Vector & sv = verts[vert.vert];
 
-          if (clipFlags == clipNONE)
-          {
-            Vid::ProjectFromCamera_I( dv, sv);
+            Vector norm;
+            tranys[vertToState[vert.vert].index[0]].Rotate( norm, normals[vert.norm]);
 
-            // set vertex fog
-            dv.SetFog();
+            bucky.LightCamInline( dv, sv, norm, colors.count ? Instance::colors[Instance::vertStart[bi] + s] : baseColor); 
+
+            if (clipFlags == clipNONE)
+            {
+              Vid::ProjectFromCamera_I( dv, sv);
+
+              // set vertex fog
+              dv.SetFog();
+            }
+            else
+            {
+              dv.vv = sv;
+            }
           }
-          else
+
+          dv.uv = uvs[vert.uv];
+          if (hasTread)
           {
-            dv.vv = sv;
+            dv.uv.v += vOffsets[vertToState[vert.vert].index[0]];
           }
+
+          remap[s] = (U16) bucky.vCount;
           bucky.SetIndex( (U16) bucky.vCount);
-          iv[ivj] = (U16) bucky.vCount;
-          in[inj] = (U16) bucky.vCount;
-          iu[iuj] = (U16) bucky.vCount;
           bucky.vCount++;
         }
-        else if (iv[ivj] != iu[iuj])
-        {
-          // old vert with new uv
-          //
-          VertexTL & dv = bucky.CurrVertexTL();
+      }
+    }
+    else
+    {
+      // clear indexers
+      //
+/*
+      memset( iv, 0xff, sizeof(U16) * bucky.vertices.count);
+      memset( in, 0xfe, sizeof(U16) * bucky.vertices.count);
+      memset( iu, 0xfd, sizeof(U16) * bucky.vertices.count);
+*/
+      memset( iv, 0xff, sizeof(U16) * vertices.count);
+      memset( in, 0xfe, sizeof(U16) * normals.count);
+      memset( iu, 0xfd, sizeof(U16) * uvs.count);
 
-          dv = bucky.GetVertexTL( iv[ivj]);
+      // for all the faces in this group
+      //
+      FaceObj * f, * fe = bucky.faces.data + bucky.faceCount;
+      for (f = bucky.faces.data; f < fe; f++)
+      {
+        FaceObj & face = *f;
+        ASSERT( face.verts[0] < vCount && face.verts[1] < vCount && face.verts[2] < vCount);
 
-          dv.uv = uvs[iuj];
-          if (hasTread)
+        // backcull
+        //
+        if (!(bucky.flags0 & RS_2SIDED))
+        {
+          Plane plane;
+          plane.Set( verts[face.verts[0]], verts[face.verts[2]], verts[face.verts[1]]);
+          if (Vid::BackCull( plane.Dot( verts[face.verts[0]])))
           {
-            dv.uv.v += vOffsets[vertToState[ivj].index[0]];
+            continue;
           }
-
-          bucky.SetIndex( (U16) bucky.vCount);
-//          iv[ivj] = (U16) bucky.vCount;
-//          in[inj] = (U16) bucky.vCount;
-//          iu[iuj] = (U16) bucky.vCount;
-          bucky.vCount++;
         }
-        else
+
+        // light, project...
+        //
+        for (U32 j = 0; j < 3; j++)
         {
-          // same old vert 
-          //
-          bucky.SetIndex( iv[ivj]);
+          U16 ivj = face.verts[j];
+	        U16 inj = face.norms[j];
+	        U16 iuj = face.uvs[j];
+
+          ASSERT( ivj < vCount && inj < normals.count && iuj < uvs.count);
+
+          if (iv[ivj] != in[inj])
+          {
+            // new vert
+            //
+            VertexTL & dv = bucky.CurrVertexTL();
+            Vector & sv = verts[ivj];
+
+            dv.uv = uvs[iuj];
+            if (hasTread)
+            {
+              dv.uv.v += vOffsets[vertToState[ivj].index[0]];
+            }
+
+            Vector norm;
+            tranys[vertToState[ivj].index[0]].Rotate( norm, normals[inj]);
+
+            if (colors.count)
+            {
+              Color c;
+              c.Modulate( colors[ivj], base.r, base.g, base.b);
+              bucky.LightCamInline( dv, sv, norm, c); 
+            }
+            else
+            {
+              bucky.LightCamInline( dv, sv, norm, baseColor); 
+            }
+
+            if (clipFlags == clipNONE)
+            {
+              Vid::ProjectFromCamera_I( dv, sv);
+
+              // set vertex fog
+              dv.SetFog();
+            }
+            else
+            {
+              dv.vv = sv;
+            }
+            bucky.SetIndex( (U16) bucky.vCount);
+            iv[ivj] = (U16) bucky.vCount;
+            in[inj] = (U16) bucky.vCount;
+            iu[iuj] = (U16) bucky.vCount;
+            bucky.vCount++;
+          }
+          else if (iv[ivj] != iu[iuj])
+          {
+            // old vert with new uv
+            //
+            VertexTL & dv = bucky.CurrVertexTL();
+
+            dv = bucky.GetVertexTL( iv[ivj]);
+
+            dv.uv = uvs[iuj];
+            if (hasTread)
+            {
+              dv.uv.v += vOffsets[vertToState[ivj].index[0]];
+            }
+
+            bucky.SetIndex( (U16) bucky.vCount);
+  //          iv[ivj] = (U16) bucky.vCount;
+  //          in[inj] = (U16) bucky.vCount;
+  //          iu[iuj] = (U16) bucky.vCount;
+            bucky.vCount++;
+          }
+          else
+          {
+            // same old vert 
+            //
+            bucky.SetIndex( iv[ivj]);
+          }
         }
       }
     }
@@ -395,6 +651,10 @@ void MeshRoot::RenderLightNoAnimVtl( Array<FaceGroup> & _buckys, U32 vCount, con
   U16 * iv, * in, * iu;
   U32 heapSize = Vid::Heap::ReqMesh( &verts, vCount, &iv, vertices.count, &in, normals.count, &iu, uvs.count);
 
+  // shared vertex streams for runs of like ents
+  //
+  Bool instance = Instance::Setup( *this, _buckys, vCount, baseColor);
+
 //  if ((_controlFlags & controlTRANSLUCENT) || baseColor.a < 255) 
   if (baseColor.a < 255) 
   {
@@ -438,119 +698,201 @@ void MeshRoot::RenderLightNoAnimVtl( Array<FaceGroup> & _buckys, U32 vCount, con
     );
     bucky.diffInitC  = (U32) Utils::FtoL(bucky.diff.a * F32(baseColor.a));
 
-    // clear indexers
-    //
-/*
-    memset( iv, 0xff, sizeof(U16) * bucky.vertices.count);
-    memset( in, 0xfe, sizeof(U16) * bucky.vertices.count);
-    memset( iu, 0xfd, sizeof(U16) * bucky.vertices.count);
-*/
-    memset( iv, 0xff, sizeof(U16) * vertices.count);
-    memset( in, 0xfe, sizeof(U16) * normals.count);
-    memset( iu, 0xfd, sizeof(U16) * uvs.count);
-
-    // for all the faces in this group
-    //
-    FaceObj * f, * fe = bucky.faces.data + bucky.faceCount;
-    for (f = bucky.faces.data; f < fe; f++)
+    if (instance)
     {
-      FaceObj & face = *f;
-      ASSERT( face.verts[0] < vCount && face.verts[1] < vCount && face.verts[2] < vCount);
-
-      // backcull
+      // shared stream for this bucky
       //
-      if (!(bucky.flags0 & RS_2SIDED))
+      U32 bi = b - _buckys.data;
+      Instance::Vert * sv0 = Instance::verts.data + Instance::vertStart[bi];
+      U16 * si    = Instance::index.data + Instance::indexStart[bi];
+      U16 * remap = Instance::remap.data;
+      memset( remap, 0xff, sizeof(U16) * Instance::vertCounts[bi]);
+
+      FaceObj * f, * fe = bucky.faces.data + bucky.faceCount;
+      for (f = bucky.faces.data; f < fe; f++, si += 3)
       {
-        // non-animating planes are pre-calced
+        FaceObj & face = *f;
+
+        // backcull
         //
-//        Plane &plane = planes[face.index];
-        Plane plane;
-        plane.Set( vertices[face.verts[0]], vertices[face.verts[1]], vertices[face.verts[2]]);
-	  	  if (plane.Evalue(Vid::Math::modelViewVector) <= 0.0f)
+        if (!(bucky.flags0 & RS_2SIDED))
         {
-          continue;
+          Plane plane;
+          plane.Set( vertices[face.verts[0]], vertices[face.verts[1]], vertices[face.verts[2]]);
+          if (plane.Evalue(Vid::Math::modelViewVector) <= 0.0f)
+          {
+            continue;
+          }
         }
-      }
 
-      // light, project...
-      //
-      for (U32 j = 0; j < 3; j++)
-      {
-        U16 ivj = face.verts[j];
-	      U16 inj = face.norms[j];
-	      U16 iuj = face.uvs[j];
-
-        ASSERT( ivj < vCount && inj < normals.count && iuj < uvs.count);
-
-        if (iv[ivj] != in[inj])
+        // light, project...
+        //
+        for (U32 j = 0; j < 3; j++)
         {
-          // new vert
-          //
-          VertexTL & dv = bucky.CurrVertexTL();
-          Vector &sv = vertices[ivj];
-
-          dv.uv = uvs[iuj];
-          if (hasTread)
+          U16 s = si[j];
+          if (remap[s] != 0xffff)
           {
-            dv.uv.v += vOffsets[vertToState[ivj].index[0]];
+            // same old vert
+            //
+            bucky.SetIndex( remap[s]);
+            continue;
           }
+          Instance::Vert & vert = sv0[s];
 
-          if (colors.count)
+          VertexTL & dv = bucky.CurrVertexTL();
+
+          if (vert.twin != 0xffff && remap[vert.twin] != 0xffff)
           {
-            Color c;
-            c.Modulate( colors[ivj], base.r, base.g, base.b);
-            bucky.LightModInline( dv, sv, normals[inj], c); 
+            // old vert with new uv
+            //
+            dv = bucky.GetVertexTL( remap[vert.twin]);
           }
           else
           {
-            bucky.LightModInline( dv, sv, normals[inj], baseColor); 
-          }
+            // new vert
+            //
+            Vector & sv = vertices[vert.vert];
 
-          Vid::TransformFromModel( dv, sv);
+            bucky.LightModInline( dv, sv, normals[vert.norm], colors.count ? Instance::colors[Instance::vertStart[bi] + s] : baseColor); 
 
-          if (clipFlags == clipNONE)
-          {
-            Vid::ProjectFromCamera_I( dv);
+            Vid::TransformFromModel( dv, sv);
 
-            // set vertex fog
-            dv.SetFog();
+            if (clipFlags == clipNONE)
+            {
+              Vid::ProjectFromCamera_I( dv);
+
+              // set vertex fog
+              dv.SetFog();
+            }
+          }
+
+          dv.uv = uvs[vert.uv];
+          if (hasTread)
+          {
+            dv.uv.v += vOffsets[vertToState[vert.vert].index[0]];
           }
 
+          remap[s] = (U16) bucky.vCount;
           bucky.SetIndex( (U16) bucky.vCount);
-          iv[ivj] = (U16) bucky.vCount;
-          in[inj] = (U16) bucky.vCount;
-          iu[iuj] = (U16) bucky.vCount;
           bucky.vCount++;
         }
-        else if (iv[ivj] != iu[iuj])
+      }
+    }
+    else
+    {
+      // clear indexers
+      //
+/*
+      memset( iv, 0xff, sizeof(U16) * bucky.vertices.count);
+      memset( in, 0xfe, sizeof(U16) * bucky.vertices.count);
+      memset( iu, 0xfd, sizeof(U16) * bucky.vertices.count);
+*/
+      memset( iv, 0xff, sizeof(U16) * vertices.count);
+      memset( in, 0xfe, sizeof(U16) * normals.count);
+      memset( iu, 0xfd, sizeof(U16) * uvs.count);
+
+      // for all the faces in this group
+      //
+      FaceObj * f, * fe = bucky.faces.data + bucky.faceCount;
+      for (f = bucky.faces.data; f < fe; f++)
+      {
+        FaceObj & face = *f;
+        ASSERT( face.verts[0] < vCount && face.verts[1] < vCount && face.verts[2] < vCount);
+
+        // backcull
+        //
+        if (!(bucky.flags0 & RS_2SIDED))
         {
-          // old vert with new uv
+          // non-animating planes are pre-calced
           //
-          VertexTL & dv = bucky.CurrVertexTL();
+  //        Plane &plane = planes[face.index];
+          Plane plane;
+          plane.Set( vertices[face.verts[0]], vertices[face.verts[1]], vertices[face.verts[2]]);
+  	  	  if (plane.Evalue(Vid::Math::modelViewVector) <= 0.0f)
+          {
+            continue;
+          }
+        }
 
-          dv = bucky.GetVertexTL( iv[ivj]);
+        // light, project...
+        //
+        for (U32 j = 0; j < 3; j++)
+        {
+          U16 ivj = face.verts[j];
+	        U16 inj = face.norms[j];
+	        U16 iuj = face.uvs[j];
 
-          dv.uv = uvs[iuj];
-          if (hasTread)
+          ASSERT( ivj < vCount && inj < normals.count && iuj < uvs.count);
+
+          if (iv[ivj] != in[inj])
           {
-            dv.uv.v += vOffsets[vertToState[ivj].index[0]];
+            // new vert
+            //
+            VertexTL & dv = bucky.CurrVertexTL();
+            Vector &sv = vertices[ivj];
+
+            dv.uv = uvs[iuj];
+            if (hasTread)
+            {
+              dv.uv.v += vOffsets[vertToState[ivj].index[0]];
+            }
+
+            if (colors.count)
+            {
+              Color c;
+              c.Modulate( colors[ivj], base.r, base.g, base.b);
+              bucky.LightModInline( dv, sv, normals[inj], c); 
+            }
+            else
+            {
+              bucky.LightModInline( dv, sv, normals[inj], baseColor); 
+            }
+
+            Vid::TransformFromModel( dv, sv);
+
+            if (clipFlags == clipNONE)
+            {
+              Vid::ProjectFromCamera_I( dv);
+
+              // set vertex fog
+              dv.SetFog();
+            }
+
+            bucky.SetIndex( (U16) bucky.vCount);
+            iv[ivj] = (U16) bucky.vCount;
+            in[inj] = (U16) bucky.vCount;
+            iu[iuj] = (U16) bucky.vCount;
+            bucky.vCount++;
           }
+          else if (iv[ivj] != iu[iuj])
+          {
+            // old vert with new uv
+            //
+            VertexTL & dv = bucky.CurrVertexTL();
 
-          bucky.SetIndex( (U16) bucky.vCount);
-//          iv[ivj] = (U16) bucky.vCount;
-//          in[inj] = (U16) bucky.vCount;
-//          iu[iuj] = (U16) bucky.vCount;
-          bucky.vCount++;
-        }
-        else
-        {
-          // same old vert 
-          //
-          bucky.SetIndex( iv[ivj]);
+            dv = bucky.GetVertexTL( iv[ivj]);
+
+            dv.uv = uvs[iuj];
+            if (hasTread)
+            {
+              dv.uv.v += vOffsets[vertToState[ivj].index[0]];
+            }
+
+            bucky.SetIndex( (U16) bucky.vCount);
+  //          iv[ivj] = (U16) bucky.vCount;
+  //          in[inj] = (U16) bucky.vCount;
+  //          iu[iuj] = (U16) bucky.vCount;
+            bucky.vCount++;
+          }
+          else
+          {
+            // same old vert 
+            //
+            bucky.SetIndex( iv[ivj]);
+          }
         }
       }
     }
-
     // flush memory and clip if necessary
     // 
     if (!Vid::UnLockBucket( bucky, clipFlags, &stateArray) && bucky.vCount > 0)
@@ -1975,6 +2317,267 @@ void MeshRoot::RenderShadowTexture( ShadowInfo & si, const Matrix ** lightA, U32
 }
 //----------------------------------------------------------------------------
 
+// cast shadow textures shared between ents with the same root, pose, orientation
+// and sun direction; free entries, then the least recently used, are handed out
+// first. entries used this frame or last are never taken.
+//
+namespace ShadowCache
+{
+  const F32 ANGLEQUANT = 64.0f;     // orientation steps per unit
+  const F32 POSITQUANT = 16.0f;     // child offset steps per meter
+
+  struct Entry
+  {
+    const MeshRoot *  root;
+    U32               key;
+    U32               stamp;        // changes whenever the entry is reused
+    U32               refs;         // ents holding it
+    S32               used;         // frame last used
+    Bitmap *          texture;
+    ShadowInfo        info;         // size and offset of the cast shadow
+  };
+
+  static Array<Entry>   entries;
+  static U32            stamp = 0;
+
+  static void Free( Entry & e)
+  {
+    e.root  = NULL;
+    e.stamp = 0;
+    e.refs  = 0;
+    e.used  = -1;
+  }
+
+  static Bool Evictable( const Entry & e, S32 frame)
+  {
+    return !e.root || e.used < frame - 1;
+  }
+
+  static void QuantVector( S32 * q, const Vector & v, F32 scale)
+  {
+    q[0] = Utils::FtoLNearest( v.x * scale);
+    q[1] = Utils::FtoLNearest( v.y * scale);
+    q[2] = Utils::FtoLNearest( v.z * scale);
+  }
+
+  // everything that changes the projected shadow, except the root itself
+  //
+  static U32 Key( const MeshRoot & root, const Array<FamilyState> & stateArray, U32 vCount, Color color, U32 blend)
+  {
+    S32 q[12];
+
+    // sun direction
+    QuantVector( q, Vid::Light::shadowMatrix.front, 1.0f / *Vid::Var::shadowCacheSun);
+    q[3] = vCount;
+    q[4] = color;
+    q[5] = blend;
+    q[6] = Vid::renderState.texShadowSize;
+    q[7] = Utils::FtoLNearest( Vid::renderState.shadowY * ANGLEQUANT);
+
+    U32 crc = Crc::Calc( q, 8 * sizeof( S32));
+
+    // orientation, and pose for animating meshes; SetVertsIdentity ignores
+    // everything else
+    //
+    const Vector & origin = stateArray[0].WorldMatrix().posit;
+    U32 i, count = root.hasAnim ? stateArray.count : 1;
+    for (i = 0; i < count; i++)
+    {
+      const Matrix & m = stateArray[i].WorldMatrix();
+
+      QuantVector( q + 0, m.right, ANGLEQUANT);
+      QuantVector( q + 3, m.up,    ANGLEQUANT);
+      QuantVector( q + 6, m.front, ANGLEQUANT);
+      QuantVector( q + 9, m.posit - origin, POSITQUANT);
+
+      crc = Crc::Calc( q, 12 * sizeof( S32), crc);
+    }
+    return crc;
+  }
+}
+//----------------------------------------------------------------------------
+
+void MeshRoot::ClearShadowCache( const MeshRoot * root) // = NULL
+{
+  ShadowCache::Entry * e, * ee = ShadowCache::entries.data + ShadowCache::entries.count;
+  for (e = ShadowCache::entries.data; e < ee; e++)
+  {
+    if (!root)
+    {
+      delete e->texture;
+    }
+    else if (e->root == root)
+    {
+      ShadowCache::Free( *e);
+    }
+  }
+  if (!root)
+  {
+    ShadowCache::entries.Release();
+
+    // don't leave ents pointing at the deleted textures
+    //
+    NList<MeshEnt>::Iterator li( &Mesh::Manager::entList); 
+    while (MeshEnt * ent = li++)
+    {
+      if (ent->shadowSlot >= 0)
+      {
+        ent->shadowSlot = -1;
+        ent->shadowTexture = ent->shadowInfo.texture = NULL;
+        ent->dirtyShadow = TRUE;
+      }
+    }
+  }
+}
+//----------------------------------------------------------------------------
+
+// give up an ent's hold on an entry; unheld entries are free for reuse
+//
+void MeshRoot::ReleaseShadowCache( S32 slot, U32 stamp)
+{
+  if ((U32) slot >= ShadowCache::entries.count || ShadowCache::entries[slot].stamp != stamp)
+  {
+    return;
+  }
+  ShadowCache::Entry & e = ShadowCache::entries[slot];
+
+  if (e.refs <= 1)
+  {
+    ShadowCache::Free( e);
+  }
+  else
+  {
+    e.refs--;
+  }
+}
+//----------------------------------------------------------------------------
+
+// TRUE if the entry is still the one the ent was given; marks it used
+//
+Bool MeshRoot::ShadowCacheValid( S32 slot, U32 stamp)
+{
+  if ((U32) slot >= ShadowCache::entries.count || ShadowCache::entries[slot].stamp != stamp)
+  {
+    return FALSE;
+  }
+  ShadowCache::entries[slot].used = Main::frameCount;
+
+  return TRUE;
+}
+//----------------------------------------------------------------------------
+
+// sun shadow through the shared cache
+// 'slot' and 'stamp' are the ent's current entry, handed back on a change
+// returns FALSE if the cache is off or no entry can be taken; the ent holds none
+//
+Bool MeshRoot::RenderShadowTextureCache( ShadowInfo & si, S32 & slot, U32 & stamp, Array<FaceGroup> & _buckys, U32 vCount, const Array<FamilyState> & stateArray, U32 _controlFlags, Color color, U32 blend) //  = 0x00000000, RS_BLEND_DEF
+{
+  if (!*Vid::Var::doShadowCache || !*Vid::Var::shadowCacheSize)
+  {
+    ReleaseShadowCache( slot, stamp);
+    slot = -1;
+
+    return FALSE;
+  }
+
+  if (!ShadowCache::entries.count)
+  {
+    ShadowCache::entries.Alloc( *Vid::Var::shadowCacheSize);
+    Utils::Memset( ShadowCache::entries.data, 0, ShadowCache::entries.size);
+
+    ShadowCache::Entry * e, * ee = ShadowCache::entries.data + ShadowCache::entries.count;
+    for (e = ShadowCache::entries.data; e < ee; e++)
+    {
+      ShadowCache::Free( *e);
+    }
+  }
+
+  U32 key = ShadowCache::Key( *this, stateArray, vCount, color, blend);
+  S32 frame = Main::frameCount;
+
+  ShadowCache::Entry * e, * ee = ShadowCache::entries.data + ShadowCache::entries.count;
+  for (e = ShadowCache::entries.data; e < ee; e++)
+  {
+    if (e->root == this && e->key == key)
+    {
+      break;
+    }
+  }
+
+  if (e < ee)
+  {
+    // hit; take the stored shadow rect
+    //
+    if (slot != e - ShadowCache::entries.data || stamp != e->stamp)
+    {
+      ReleaseShadowCache( slot, stamp);
+      e->refs++;
+    }
+    e->used = frame;
+
+    si.size       = e->info.size;
+    si.radx       = e->info.radx;
+    si.rady       = e->info.rady;
+    si.radxRender = e->info.radxRender;
+    si.radyRender = e->info.radyRender;
+    si.p1         = e->info.p1;
+    si.texture    = e->texture;
+
+    slot  = e - ShadowCache::entries.data;
+    stamp = e->stamp;
+
+    return TRUE;
+  }
+
+  // miss; hand back the ent's own entry, then take a free or the oldest idle one
+  //
+  ReleaseShadowCache( slot, stamp);
+  slot = -1;
+
+  ShadowCache::Entry * old = NULL;
+  for (e = ShadowCache::entries.data; e < ee; e++)
+  {
+    if (ShadowCache::Evictable( *e, frame) && (!old || e->used < old->used))
+    {
+      old = e;
+    }
+  }
+  if (!old)
+  {
+    // all in recent use; the caller renders its own
+    return FALSE;
+  }
+
+  e = old;
+  if (!e->texture)
+  {
+    GameIdent gi;
+    sprintf( gi.str, "ShadowCache%u", e - ShadowCache::entries.data);
+
+    e->texture = new Bitmap( Bitmap::reduceHIGH, gi.str, 0, bitmapTEXTURE | bitmapNORELOAD);
+    ASSERT( e->texture);
+    e->texture->Create( Vid::renderState.texShadowSize, Vid::renderState.texShadowSize, TRUE, 0, 0);
+  }
+  e->root  = this;
+  e->key   = key;
+  e->stamp = ++ShadowCache::stamp;
+  e->refs  = 1;
+  e->used  = frame;
+
+  const Matrix * lA = &Vid::Light::shadowMatrix;
+  si.texture = e->texture;
+
+  RenderShadowTexture( si, &lA, 1, _buckys, vCount, stateArray, _controlFlags, color, blend);
+
+  e->info = si;
+
+  slot  = e - ShadowCache::entries.data;
+  stamp = e->stamp;
+
+  return TRUE;
+}
+//----------------------------------------------------------------------------
+
 void MeshRoot::RenderShadowVerts( const Vector & vect, Area<F32> & size, U32 type, Vector * vA, U32 vCount, const Array<FamilyState> & stateArray, U32 _controlFlags, Color color, U32 blend) //  = 0x00000000, NULL, RS_BLEND_DEF
 {
   blend;
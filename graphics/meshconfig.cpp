@@ -151,14 +151,87 @@ void MeshConfig::ConfigureAnim(FScope *pScope)
 }
 //----------------------------------------------------------------------------
 
-// checks for a god file
+// anything that changes the imported root must be in here, since roots
+// loaded from the cache skip the config step just like god files do
+//
+U32 MeshConfig::CacheKey()
+{
+  FileDrive drive;
+  FileDir dir;
+  FileName fname;
+  FileExt ext;
+  Dir::PathExpand(name.str, drive, dir, fname, ext);
+
+  FileSys::DataFile *file = FileSys::Open(name.str);
+  if (!file)
+  {
+    return 0;
+  }
+  U32 crc = file->DataCrc();
+  FileSys::Close(file);
+
+  // animation files and their settings
+  FileString strbuf;
+  for (List<Animation>::Iterator n(&animations); *n; n++)
+  {
+    Animation &anim = *(*n);
+
+    Utils::Sprintf(strbuf.str, MAX_FILEIDENT, "%s-%s%s", fname.str, anim.name.str, ext.str);
+
+    if ((file = FileSys::Open(strbuf.str)) != NULL)
+    {
+      crc = file->DataCrc(crc);
+      FileSys::Close(file);
+    }
+    F32 animParams[] = 
+    {
+      F32(anim.type), anim.animSpeed, anim.framesPerMeter, anim.controlFrame
+    };
+    crc = Crc::Calc(animParams, sizeof(animParams), Crc::CalcStr(anim.name.str, crc));
+  }
+
+  // config and import settings
+  F32 params[] =
+  {
+    scale, texTimer, shadowRadius, treadPerMeter, mrmFactor, mrmMaxFactor, F32(mrmMin),
+    F32(mrm), F32(envMap), F32(quickLight), F32(chunkify), 
+    F32(shadowGeneric), F32(shadowSemiLive), F32(shadowLive),
+    *Vid::Var::vertexThresh, *Vid::Var::normalThresh, *Vid::Var::tcoordThresh,
+    *Vid::Var::mrmMergeThresh, *Vid::Var::mrmNormalCrease, F32(*Vid::Var::mrmMultiNormals),
+    F32(*Vid::Var::doOptimize), F32(*Vid::Var::doFrogPose), F32(*Vid::Var::doBasePose), 
+    F32(*Vid::Var::doGenericMat)
+  };
+  crc = Crc::Calc(params, sizeof(params), Crc::CalcStr(fileName.str, crc));
+
+  // zero means no key
+  return crc ? crc : 1;
+}
+//----------------------------------------------------------------------------
+
+// checks for a god file, then for a cached import
 //
 void MeshConfig::PostLoad()
 {
-  meshRoot = Mesh::Manager::FindRead(isNullMesh ? NULL : name.str, scale, mrm, fileName.str);
+  U32 cacheKey = 0;
+  if (!isNullMesh && Vid::Var::doLoadCache)
+  {
+    // roots already in memory are shared, not imported
+    if (!Mesh::Manager::Find(name.str) && !Mesh::Manager::Find(fileName.str))
+    {
+      cacheKey = CacheKey();
+    }
+  }
+
+  meshRoot = Mesh::Manager::FindRead(isNullMesh ? NULL : name.str, scale, mrm, fileName.str, cacheKey);
 
   PostConfig();
 
+  if (cacheKey && meshRoot && !meshRoot->godLoad)
+  {
+    // fully processed now; next time load it at god file speed
+    meshRoot->SaveCache( cacheKey);
+  }
+
 #if 0
   if (!isNullMesh && !meshRoot->doLoadGod)
   {
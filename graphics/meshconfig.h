@@ -100,6 +100,9 @@ struct MeshConfig
     return Save( name.str);
   }
 
+  // Crc of the source files and settings that make up the root
+  U32 CacheKey();
+
   // Post load the configuration
   void PostLoad();
   void PostLoadXSI();
@@ -207,6 +207,8 @@ void MeshEnt::ClearData()
   animState0.ClearData();
   animStateR.ClearData();
   interpolated = FALSE;
+  inView = TRUE;
+  animSkipped = FALSE;
   interpFrame = 0.0f;
 
   viewOrigin.ClearData();
@@ -235,6 +237,9 @@ void MeshEnt::ClearData()
   alphaCurrent = 255;
 
   shadowTexture = NULL;
+  shadowTexOwn = NULL;
+  shadowSlot = -1;
+  shadowStamp = 0;
   shadowTime = 0;
   shadowAlpha0 = 255;
   shadowAlpha1 = 0;
@@ -285,6 +290,8 @@ void MeshEnt::ReleaseBuckys()
 
 MeshEnt::~MeshEnt()
 {
+  MeshRoot::ReleaseShadowCache( shadowSlot, shadowStamp);
+
 #if 1
   // remove the effect
   //
@@ -851,8 +858,9 @@ void MeshEnt::SimulateSim( F32 dt)
 //----------------------------------------------------------------------------
 
 // setup render states via animation
+// 'hidden' ents keep their frame counters running but don't sample keyframes
 //
-void MeshEnt::SimulateInt( F32 dt, Bool isInterpFrame) // = TRUE
+void MeshEnt::SimulateInt( F32 dt, Bool isInterpFrame, Bool hidden) // = TRUE, = FALSE
 {
   isInterpFrame;
 
@@ -887,26 +895,47 @@ void MeshEnt::SimulateInt( F32 dt, Bool isInterpFrame) // = TRUE
     dirtyShadow = TRUE;
   }
 
-  SimulateIntRecurse( dt, dtdi);
+  SimulateIntRecurse( dt, dtdi, hidden);
 
   if (dirtyIntAll)
   {
-    SetWorldRecurseRender( statesR[0].WorldMatrix(), &statesR[0]);
+    if (intBatching)
+    {
+      // the node states aren't lerped until FlushIntBatch
+      AddIntEnt( this);
+    }
+    else
+    {
+      SetWorldRecurseRender( statesR[0].WorldMatrix(), &statesR[0]);
+    }
     dirtyShadow = TRUE;
   }
 }
 //----------------------------------------------------------------------------
 
-void MeshEnt::SimulateIntRecurse( F32 dt, F32 dtdi)
+void MeshEnt::SimulateIntRecurse( F32 dt, F32 dtdi, Bool hidden) // = FALSE
 {
-  if (animStateR.active)
+  if (animStateR.active || (animSkipped && !hidden))
   {
-    animStateR.lastFrame = animStateR.curFrame;
+    if (animStateR.active)
+    {
+      // keep the earliest frame of a skipped run so a cycle start isn't lost
+      animStateR.lastFrame = animSkipped ? Min<F32>( animStateR.lastFrame, animStateR.curFrame) : animStateR.curFrame;
 
-    animStateR.curFrame += dt * fps * animStateR.dir;
-    ClampFrame( animStateR);
+      animStateR.curFrame += dt * fps * animStateR.dir;
+      ClampFrame( animStateR);
+    }
 
-    SetFrameSimulate( animStateR, animStateR.lastFrame, statesR);
+    if (hidden)
+    {
+      // catch up on the first visible frame
+      animSkipped = TRUE;
+    }
+    else
+    {
+      SetFrameSimulate( animStateR, animStateR.lastFrame, statesR);
+      animSkipped = FALSE;
+    }
 
     dirtyIntAll = TRUE;
     if (eParent)
@@ -922,6 +951,12 @@ void MeshEnt::SimulateIntRecurse( F32 dt, F32 dtdi)
     AnimKey * src1 = &states1[1];
     for (ss = &statesR[1]; ss < es; ss++, src0++, src1++)
     {
+      if (intBatching && (src1->type & animCONDIRTY))
+      {
+        // lerped and set up in FlushIntBatch
+        AddIntNode( ss, src0, src1, dtdi);
+        continue;
+      }
       if (src1->type & animCONDIRTY)
       {
         ss->Set( src0->GetRotation().Slerp( src1->GetRotation(), dtdi));
@@ -945,12 +980,209 @@ void MeshEnt::SimulateIntRecurse( F32 dt, F32 dtdi)
   MeshEnt * node;
   while ((node = kids++) != NULL)
   {
-    node->SimulateIntRecurse( dt, dtdi);
+    node->SimulateIntRecurse( dt, dtdi, hidden);
   }
   interpolated = TRUE;
 }
 //----------------------------------------------------------------------------
 
+// batched node interpolation
+//
+// while a batch is open SimulateIntRecurse gathers the controlled nodes of
+// every ent instead of lerping them one at a time, and SimulateInt holds
+// the world matrix update.  FlushIntBatch copies the gathered keys into SoA
+// streams, lerps them all in one pass and scatters the results to statesR.
+//
+struct IntNode
+{
+  FamilyState *           dst;
+  const FamilyState *     src0;
+  const AnimKey *         src1;
+  F32                     t;
+};
+
+// stream layout: the 'a' streams take the results
+//
+enum
+{
+  isAQS, isAQX, isAQY, isAQZ,  isAPX, isAPY, isAPZ,  isASX, isASY, isASZ,
+  isBQS, isBQX, isBQY, isBQZ,  isBPX, isBPY, isBPZ,  isBSX, isBSY, isBSZ,
+  isT,
+  isCOUNT
+};
+
+Bool                      MeshEnt::intBatching;
+static Array<IntNode>     intNodes;
+static U32                intNodeCount;
+static Array<MeshEnt *>   intEnts;
+static U32                intEntCount;
+static Array<F32, 16>     intStreams;
+//----------------------------------------------------------------------------
+
+void MeshEnt::AddIntNode( FamilyState * dst, const FamilyState * src0, const AnimKey * src1, F32 t)
+{
+  if (intNodeCount == intNodes.count)
+  {
+    Array<IntNode> grow( Max<U32>( 256, intNodes.count * 2));
+    if (intNodeCount)
+    {
+      memcpy( grow.data, intNodes.data, intNodeCount * sizeof( IntNode));
+    }
+    intNodes.Swap( grow);
+  }
+  IntNode & node = intNodes[intNodeCount++];
+  node.dst  = dst;
+  node.src0 = src0;
+  node.src1 = src1;
+  node.t    = t;
+}
+//----------------------------------------------------------------------------
+
+void MeshEnt::AddIntEnt( MeshEnt * ent)
+{
+  if (intEntCount == intEnts.count)
+  {
+    Array<MeshEnt *> grow( Max<U32>( 256, intEnts.count * 2));
+    if (intEntCount)
+    {
+      memcpy( grow.data, intEnts.data, intEntCount * sizeof( MeshEnt *));
+    }
+    intEnts.Swap( grow);
+  }
+  intEnts[intEntCount++] = ent;
+}
+//----------------------------------------------------------------------------
+
+// sign corrected linear blend of 'count' keys, as Quaternion::Slerp
+// 'stride' is a multiple of 4
+//
+static void LerpStreams( F32 * s, U32 stride, U32 count)
+{
+  for (U32 i = 0; i < count; i++)
+  {
+    F32 * p = s + i;
+    F32 t = p[isT * stride];
+
+    F32 dot = p[isAQS * stride] * p[isBQS * stride] + p[isAQX * stride] * p[isBQX * stride]
+            + p[isAQY * stride] * p[isBQY * stride] + p[isAQZ * stride] * p[isBQZ * stride];
+    F32 flip = dot < 0 ? -1.0f : 1.0f;
+
+    U32 j;
+    for (j = isAQS; j <= isASZ; j++)
+    {
+      F32 & a = p[j * stride];
+      F32 b = p[(j + isBQS - isAQS) * stride];
+      if (j <= isAQZ)
+      {
+        b *= flip;
+      }
+      a = a + (b - a) * t;
+    }
+  }
+}
+//----------------------------------------------------------------------------
+
+void MeshEnt::StartIntBatch()
+{
+  intNodeCount = 0;
+  intEntCount  = 0;
+  intBatching  = TRUE;
+}
+//----------------------------------------------------------------------------
+
+void MeshEnt::FlushIntBatch()
+{
+  intBatching = FALSE;
+
+  U32 count  = intNodeCount;
+  U32 stride = (count + 3) & ~3;
+
+  if (count)
+  {
+    if (intStreams.count < stride * isCOUNT)
+    {
+      intStreams.Alloc( stride * isCOUNT);
+    }
+    F32 * s = intStreams.data;
+
+    // gather
+    //
+    U32 i;
+    for (i = 0; i < count; i++)
+    {
+      const IntNode & node = intNodes[i];
+      const Quaternion & qa = node.src0->GetRotation();
+      const Quaternion & qb = node.src1->GetRotation();
+      const Vector & pa = node.src0->GetPosition();
+      const Vector & pb = node.src1->GetPosition();
+      const Vector & sa = node.src0->GetScale();
+      const Vector & sb = node.src1->GetScale();
+
+      s[isAQS * stride + i] = qa.s;   s[isBQS * stride + i] = qb.s;
+      s[isAQX * stride + i] = qa.v.x; s[isBQX * stride + i] = qb.v.x;
+      s[isAQY * stride + i] = qa.v.y; s[isBQY * stride + i] = qb.v.y;
+      s[isAQZ * stride + i] = qa.v.z; s[isBQZ * stride + i] = qb.v.z;
+      s[isAPX * stride + i] = pa.x;   s[isBPX * stride + i] = pb.x;
+      s[isAPY * stride + i] = pa.y;   s[isBPY * stride + i] = pb.y;
+      s[isAPZ * stride + i] = pa.z;   s[isBPZ * stride + i] = pb.z;
+      s[isASX * stride + i] = sa.x;   s[isBSX * stride + i] = sb.x;
+      s[isASY * stride + i] = sa.y;   s[isBSY * stride + i] = sb.y;
+      s[isASZ * stride + i] = sa.z;   s[isBSZ * stride + i] = sb.z;
+      s[isT   * stride + i] = node.t;
+    }
+    // keep the pad lanes finite
+    for ( ; i < stride; i++)
+    {
+      for (U32 j = 0; j < isCOUNT; j++)
+      {
+        s[j * stride + i] = 0.0f;
+      }
+    }
+
+    LerpStreams( s, stride, count);
+
+    // scatter
+    //
+    for (i = 0; i < count; i++)
+    {
+      FamilyState & ss = *intNodes[i].dst;
+
+      Quaternion q;
+      q.Set( s[isAQS * stride + i], s[isAQX * stride + i], s[isAQY * stride + i], s[isAQZ * stride + i]);
+      ss.Set( q, Vector( s[isAPX * stride + i], s[isAPY * stride + i], s[isAPZ * stride + i]));
+      ss.SetScale( Vector( s[isASX * stride + i], s[isASY * stride + i], s[isASZ * stride + i]));
+
+      ss.SetObject();
+      ss.SetObjectScale();
+
+      ss.type &= ~animALLDIRTY;
+    }
+  }
+
+  // world matrices for the ents held by SimulateInt
+  //
+  for (U32 e = 0; e < intEntCount; e++)
+  {
+    MeshEnt & ent = *intEnts[e];
+    ent.SetWorldRecurseRender( ent.statesR[0].WorldMatrix(), &ent.statesR[0]);
+  }
+
+  intNodeCount = 0;
+  intEntCount  = 0;
+}
+//----------------------------------------------------------------------------
+
+void MeshEnt::ReleaseIntBatch()
+{
+  intNodes.Release();
+  intEnts.Release();
+  intStreams.Release();
+
+  intNodeCount = 0;
+  intEntCount  = 0;
+}
+//----------------------------------------------------------------------------
+
 // meter per sec
 //
 void MeshEnt::SetTreadRate( NodeIdent & ident, F32 rate)
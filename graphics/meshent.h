@@ -120,6 +120,9 @@ public:
 
   ShadowInfo              shadowInfo;
   Bitmap *                shadowTexture;
+  Bitmap *                shadowTexOwn;   // used when the shared shadow cache is full or off
+  S32                     shadowSlot;     // shared shadow cache entry; -1 = own texture
+  U32                     shadowStamp;
   U32                     shadowTime;
   S32                     shadowAlpha0;
   S32                     shadowAlpha1;
@@ -169,6 +172,8 @@ public:
   U32                     interpolated : 1;   
   U32                     effecting    : 1;   
   U32                     visible      : 1;   
+  U32                     inView       : 1;   // ent or its shadow made the last display list
+  U32                     animSkipped  : 1;   // keyframes not sampled while out of view
 
   AnimList *              curCycle;           // current animation cycle
   AnimList *              conCycle;           // control cycle overlay
@@ -492,8 +497,18 @@ public:
   Bool UpdateSim( F32 dt);
 
   void SimulateSim( F32 dt);
-  void SimulateInt( F32 dt, Bool isInterpFrame = TRUE);
-  void SimulateIntRecurse( F32 dt, F32 dtdi);
+  void SimulateInt( F32 dt, Bool isInterpFrame = TRUE, Bool hidden = FALSE);
+  void SimulateIntRecurse( F32 dt, F32 dtdi, Bool hidden = FALSE);
+
+  // batch the node lerps of many SimulateInt calls into one pass
+  //
+  static Bool intBatching;
+  static void AddIntNode( FamilyState * dst, const FamilyState * src0, const AnimKey * src1, F32 t);
+  static void AddIntEnt( MeshEnt * ent);
+  static void StartIntBatch();
+  static void FlushIntBatch();
+  static void ReleaseIntBatch();
+
   void SimulateIntBasic( F32 dt, Bool simFrame = TRUE);
   void SimulateTex( F32 dt, Bool simFrame = TRUE);
   void SetTexFrame( U32 frame = 0);
@@ -596,6 +611,12 @@ public:
   //
   void RenderShadowTexture( const Matrix ** lightA = NULL, U32 lCount = 1, Color color = 0xffffffff, U32 blend = RS_BLEND_DEF);
 
+  // FALSE if the shared shadow texture has been handed to another mesh
+  Bool ShadowCacheValid()
+  {
+    return shadowSlot < 0 || MeshRoot::ShadowCacheValid( shadowSlot, shadowStamp);
+  }
+
   // mesh effects specialized renders
   //
   void RenderTextCrossFadeEffect();
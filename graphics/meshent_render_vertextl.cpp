@@ -83,7 +83,7 @@ void MeshEnt::SetFeatureLOD()
   Vector pos = viewOrigin;
   pos.z -= Vid::renderState.mrmDist;
   lodValue = pos.z * root.mrmFactor * Vid::renderState.mrmFactor1
-    * Vid::renderState.mrmFactor2 / (20.0f * ObjectBoundsRender().Radius());
+    * Vid::renderState.mrmFactor2 * Vid::renderState.mrmAutoFactor / (20.0f * ObjectBoundsRender().Radius());
 
   // set mrm
   // 
@@ -549,30 +549,42 @@ void MeshEnt::RenderShadowTexture( const Matrix ** lightA, U32 lCount, Color col
 //  color.a = (U8) fa.i;
 //  done in Terrain::BoundsTestShadow
   
-  if (!shadowTexture)
-  {
-    static counter = 0;
-    GameIdent gi;
-    sprintf( gi.str, "LiveShadow%u", counter);
-    counter++;
+  shadowInfo.uv0.Set( 0, 1);
+  shadowInfo.uv1.Set( 1, 1);
+  shadowInfo.uv2.Set( 1, 0);
 
-//    shadowTexture = new Bitmap( bitmapTEXTURE | bitmapNORELOAD);
-    shadowTexture = new Bitmap( Bitmap::reduceHIGH, gi.str, 0, bitmapTEXTURE | bitmapNORELOAD);
-    ASSERT( shadowTexture);
-    shadowTexture->Create( Vid::renderState.texShadowSize, Vid::renderState.texShadowSize, TRUE, 0, 0);
+  // sun only shadows of ents that don't animate them are shared between like ents
+  //
+  if (!lightA && shadowType != MeshRoot::shadowLIVE && RootPriv().RenderShadowTextureCache( shadowInfo, shadowSlot, shadowStamp, buckys, vertCount, statesR, controlFlags, color, blend))
+  {
+    shadowTexture = shadowInfo.texture;
   }
-  if (!lightA)
+  else
   {
+    if (!shadowTexOwn)
+    {
+      static counter = 0;
+      GameIdent gi;
+      sprintf( gi.str, "LiveShadow%u", counter);
+      counter++;
+
+//      shadowTexOwn = new Bitmap( bitmapTEXTURE | bitmapNORELOAD);
+      shadowTexOwn = new Bitmap( Bitmap::reduceHIGH, gi.str, 0, bitmapTEXTURE | bitmapNORELOAD);
+      ASSERT( shadowTexOwn);
+      shadowTexOwn->Create( Vid::renderState.texShadowSize, Vid::renderState.texShadowSize, TRUE, 0, 0);
+    }
     const Matrix * lA = &Vid::Light::shadowMatrix;
-    lightA = &lA;
-    lCount = 1;
-  }
-  shadowInfo.uv0.Set( 0, 1);
-  shadowInfo.uv1.Set( 1, 1);
-  shadowInfo.uv2.Set( 1, 0);
-  shadowInfo.texture = shadowTexture;
+    if (!lightA)
+    {
+      lightA = &lA;
+      lCount = 1;
+    }
+    MeshRoot::ReleaseShadowCache( shadowSlot, shadowStamp);
+    shadowSlot = -1;
+    shadowTexture = shadowInfo.texture = shadowTexOwn;
 
-  RootPriv().RenderShadowTexture( shadowInfo, lightA, lCount, buckys, vertCount, statesR, controlFlags, color, blend);
+    RootPriv().RenderShadowTexture( shadowInfo, lightA, lCount, buckys, vertCount, statesR, controlFlags, color, blend);
+  }
 
   dirtyShadow = FALSE;
   shadowTime = Main::thisTime + CLOCKS_PER_SEC * 30;
@@ -27,6 +27,9 @@ const char *MeshRootBlock12 = "MeshRoot 12.0";
 
 // Shadow plane block key
 const char *ShadowPlaneBlock = "ShadowPlane 1.0";
+
+// Cached xsi import key block
+const char *MeshCacheBlock = "MeshCache 1.0";
 //----------------------------------------------------------------------------
 
 void Mesh::LoadAnimation( GodFile *god, Animation &animation, AnimType type)
@@ -45,15 +48,12 @@ void Mesh::LoadAnimation( GodFile *god, Animation &animation, AnimType type)
 
     if ((key0.type == animQUATERNION) && (key1.type == animQUATERNION) && key0.quaternion == key1.quaternion)
     {
-      Array<AnimKey> keys(animation.keys.count-1);
-      for (U32 i = 0; i < animation.keys.count-1; i++)
-      {
-        keys[i] = animation.keys[i];
-      }
-      keys.Swap( animation.keys);
+      // trim it in place; the slack goes when the array is released
+      animation.keys.count--;
 
 //      LOG_DIAG(("removing redundant end key"));
 
+      Array<AnimKey> & keys = animation.keys;
       F32 dot = keys[keys.count-2].quaternion.Dot( keys[keys.count-1].quaternion);
       if (dot < 0)
       {
@@ -582,19 +582,7 @@ MeshRoot *Mesh::Manager::FindLoad( const char *godFileName)
   {
     GodFile god(bFile.GetBlockPtr(), size, ver);
 
-    root = new MeshRoot();
-    root->Load( &god);
-
-    if (!SetupRoot( *root, name.str))
-    {
-      ERR_FATAL( ("Error loading %s", name.str));
-    }
-    root->Check();  // FIXME
-
-    if (root->shadowType == MeshRoot::shadowGENERIC)
-    {
-      root->RenderShadowTextureGeneric();
-    }
+    root = LoadRoot( god, name.str);
 
     bFile.CloseBlock();
     bFile.Close();
@@ -609,6 +597,123 @@ MeshRoot *Mesh::Manager::FindLoad( const char *godFileName)
 }
 //----------------------------------------------------------------------------
 
+MeshRoot *Mesh::Manager::LoadRoot( GodFile &god, const char *rootName)
+{
+  MeshRoot *root = new MeshRoot();
+  root->Load( &god);
+
+  if (!SetupRoot( *root, rootName))
+  {
+    ERR_FATAL( ("Error loading %s", rootName));
+  }
+  root->Check();  // FIXME
+
+  if (root->shadowType == MeshRoot::shadowGENERIC)
+  {
+    root->RenderShadowTextureGeneric();
+  }
+
+  return root;
+}
+//----------------------------------------------------------------------------
+
+// cached imports are named after the xsi file and hold the key 
+// of the source data and settings they were built from
+//
+MeshRoot *Mesh::Manager::FindCache( const char *meshName, const char *fileName, U32 cacheKey)
+{
+  FileDrive drive;
+  FileDir dir;
+  FileName name;
+  FileExt ext;
+  Dir::PathExpand( meshName, drive, dir, name, ext);
+
+  // same root name as FindRead
+  BuffString buff;
+  if (fileName)
+  {
+    FileName fname;
+    Dir::PathExpand( fileName, drive, dir, fname, ext);
+    buff = fname.str;
+  }
+  else
+  {
+    Mesh::Manager::MakeName( buff, name.str, Vid::Var::scaleFactor);
+  }
+
+  MeshRoot *root = Find( name.str);
+  if (root)
+  {
+    return root;
+  }
+  root = Find( buff.str);
+  if (root)
+  {
+    return root;
+  }
+
+  FilePath path;
+  Dir::PathMake( path, NULL, Vid::Var::cacheFilePath, name.str, "god");
+
+  BlockFile bFile;
+  if (!bFile.Open( path.str, BlockFile::READ, FALSE))
+  {
+    return NULL;
+  }
+
+  // stale if the source or the import settings have changed
+  U32 key = 0, size;
+  if (bFile.ReadBlock( MeshCacheBlock, &key, sizeof(key), FALSE) && key == cacheKey
+   && bFile.OpenBlock( MeshRootBlock12, FALSE, &size))
+  {
+    GodFile god(bFile.GetBlockPtr(), size, 12);
+
+    root = LoadRoot( god, buff.str);
+
+    bFile.CloseBlock();
+
+    LOG_DIAG( ("Loaded cached import for %s", name.str) );
+  }
+  bFile.Close();
+
+  return root;
+}
+//----------------------------------------------------------------------------
+
+Bool MeshRoot::SaveCache( U32 cacheKey)
+{
+  Dir::MakeFull( Vid::Var::cacheFilePath);
+
+  FilePath path;
+  Dir::PathMake( path, NULL, Vid::Var::cacheFilePath, xsiName.str, "god");
+
+  BlockFile bFile;
+  if (!bFile.Open( path.str, BlockFile::CREATE, FALSE))
+  {
+    LOG_ERR((bFile.LastError()))
+    return (FALSE);
+  }
+
+  // an interrupted save leaves no key block and so never matches
+  Bool retValue = FALSE;
+  if (bFile.OpenBlock( MeshRootBlock12))
+  {
+    GodFile god(&bFile);
+    Save( &god);
+    bFile.CloseBlock();
+
+    retValue = bFile.WriteBlock( MeshCacheBlock, &cacheKey, sizeof(cacheKey), FALSE);
+  }
+  bFile.Close();
+
+  if (retValue)
+  {
+    LOG_DIAG( ("Cached import for %s", xsiName.str) );
+  }
+  return retValue;
+}
+//----------------------------------------------------------------------------
+
 Bool MeshRoot::Load( GodFile *god)
 {
   god->LoadStr(xsiName.str, MAX_GAMEIDENT);
@@ -669,26 +774,30 @@ Bool MeshRoot::Load( GodFile *god)
     God::Load(*god, treadPerMeter);
   }
 
-  God::LoadArray4(*god, vertices, Vid::renderState.maxVerts);
-  God::LoadArray4(*god, normals, Vid::renderState.maxVerts);
-  God::LoadArray4(*god, uvs, Vid::renderState.maxVerts);
-  God::LoadArray4(*god, colors, Vid::renderState.maxVerts);
+  God::LoadArray4Raw(*god, vertices, Vid::renderState.maxVerts);
+  God::LoadArray4Raw(*god, normals, Vid::renderState.maxVerts);
+  God::LoadArray4Raw(*god, uvs, Vid::renderState.maxVerts);
+  God::LoadArray4Raw(*god, colors, Vid::renderState.maxVerts);
 
   God::LoadArray(*god, faces, Vid::renderState.maxTris);
   God::LoadArray(*god, buckys, MAXBUCKYS);
   God::LoadArray(*god, vertToState, Vid::renderState.maxVerts);
-  God::LoadArray(*god, planes, Vid::renderState.maxTris);
+  God::LoadArrayRaw(*god, planes, Vid::renderState.maxTris);
   
-  God::LoadArray(*god, stateMats, MAXMESHPERGROUP);
+  God::LoadArrayRaw(*god, stateMats, MAXMESHPERGROUP);
 
-  Array<AnimKey> keys;
-  God::LoadArray(*god, keys, MAXMESHPERGROUP);
-
-  states.Alloc( keys.count);
-  U32 i;
-  for (i = 0; i < keys.count; i++)
+  // rest state keys go straight into the states
+  U32 i, count = god->LoadU32();
+  if (count > MAXMESHPERGROUP)
+  {
+    ERR_FATAL(("GodFile::LoadArray: overflow %d ; max %d", count, MAXMESHPERGROUP));
+  }
+  states.Alloc( count);
+  for (i = 0; i < count; i++)
   {
-    states[i] = keys[i];
+    AnimKey key;
+    God::Load(*god, key);
+    states[i] = key;
   }
 
   for (i = 0; i < faces.count; i++)
@@ -864,13 +973,13 @@ void Mesh::Load( GodFile *god, MeshRoot &root, Mesh *_parent, Bool isPrimary)
   {
     MeshData mdata;
 
-    God::LoadArray4(*god, mdata.vertices);
-    God::LoadArray4(*god, mdata.normals);
-    God::LoadArray4(*god, mdata.uvs);
-    God::LoadArray4(*god, mdata.colors);
+    God::LoadArray4Raw(*god, mdata.vertices);
+    God::LoadArray4Raw(*god, mdata.normals);
+    God::LoadArray4Raw(*god, mdata.uvs);
+    God::LoadArray4Raw(*god, mdata.colors);
 
     God::LoadArray( *god, mdata.groups);
-    God::LoadArray4(*god, mdata.indices);
+    God::LoadArray4Raw(*god, mdata.indices);
 
     if (mdata.vertices.count)
     {
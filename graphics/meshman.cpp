@@ -8,7 +8,7 @@
 //
 
 //#include "vid_publicmore.h"
-#include "vid_public.h"
+#include "vid_private.h"
 #include "terrain_priv.h"
 #include "light_priv.h"
 #include "meshent.h"
@@ -19,6 +19,8 @@
 #include "terrain.h"
 #include "iface.h"
 #include "hardware.h"
+#include "perfstats.h"
+#include "clock.h"
 //----------------------------------------------------------------------------
 
 #define MRMAUTOSPEED    0.004f
@@ -134,6 +136,8 @@ void Mesh::Manager::DisposeAll()
   }
   entList.DisposeAll();
 
+  MeshRoot::ClearShadowCache();
+  MeshRoot::ClearInstance();
   rootTree.DisposeAll();
 
   // rootTree.DisposeAll destroyed it
@@ -150,6 +154,8 @@ void Mesh::Manager::Done()
 {
   DisposeAll();
 
+  MeshEnt::ReleaseIntBatch();
+
   Statistics::Done();
 
   sysInit = FALSE;
@@ -176,118 +182,151 @@ void Mesh::Manager::ResetCounts()
 }
 //----------------------------------------------------------------------------
 
-void Mesh::Manager::UpdateMRMFactor()
+void Mesh::Manager::OnModeChange()
 {
-  if (!Vid::renderState.status.mrmAuto)
+  if (sysInit)
   {
-    return;
+    SetupRenderProcList();
   }
+}
+//----------------------------------------------------------------------------
+
+void Mesh::Manager::MakeName( BuffString &buff, const char *meshName, F32 scale) // = 1.0f)
+{
+  FileDrive drive;
+  FileDir dir;
+  FileName name;
+  FileExt ext;
 
-#if 1
-  S32 value = Main::triCount;
+  Dir::PathExpand( meshName, drive, dir, name, ext);
+
+  buff = meshName;
+  char *str = buff.str + Utils::Strlen(buff.str);
+  sprintf( str, " %4.4f", scale);
+}
+//----------------------------------------------------------------------------
 
-  static F32 error0 = 0.0f;
-  F32 target, error;
-  S32 dv;
+static int _cdecl CompareInstance( const void *e1, const void *e2)
+{
+  const MeshEnt * ent1 = *(const MeshEnt **) e1;
+  const MeshEnt * ent2 = *(const MeshEnt **) e2;
 
-  if (value < Vid::renderState.mrmLow)
+  const MeshRoot * root1 = &ent1->Root();
+  const MeshRoot * root2 = &ent2->Root();
+  if (root1 != root2)
   {
-    // too few
-    dv = value - S32(Vid::renderState.mrmLow);
-//    target = F32(dv) * 0.004f;
-    target = F32(dv);
-    error = error0 + (target - error0) * Vid::renderState.mrmAutoConstant1;
+    return root1 < root2 ? -1 : 1;
   }
-  else if (value > Vid::renderState.mrmHigh)
+  if (ent1->vertCount != ent2->vertCount)
   {
-    // too many
-    dv = value - S32(Vid::renderState.mrmHigh);
-//    target = F32(dv) * 0.004f;
-    target = F32(dv);
-    error = error0 + (target - error0) * Vid::renderState.mrmAutoConstant1;
+    return ent1->vertCount < ent2->vertCount ? -1 : 1;
   }
-  else
+
+  // alpha doesn't go into the streams
+  U32 c1 = U32(ent1->baseColor) & 0x00ffffff;
+  U32 c2 = U32(ent2->baseColor) & 0x00ffffff;
+  if (c1 != c2)
   {
-    // in bounds; slowly adjust to Vid::renderState.mrmHigh
-    dv = value - S32(Vid::renderState.mrmLow);
-//    target = F32(dv) * 0.004f;
-    target = F32(dv);
-    error = error0 + (target - error0) * Vid::renderState.mrmAutoConstant2 * target * 0.5f;
-//    error = error0 + (target - error0) * *Vid::renderState.status.mrmAutoConstant2;
+    return c1 < c2 ? -1 : 1;
   }
+  return 0;
+}
+//----------------------------------------------------------------------------
 
-#else
-  S32 elap = S32(Main::elapLast);
+// ent render pass timing and the mesh.bench.instance A/B run
+//
+static U32 instanceStart;
+static U32 instanceEnts;
+
+static U32 benchFrames;
+static U32 benchFrame;
+static S32 benchRestore;
+static U32 benchUs[2];
+static U32 benchEnts[2];
+static U32 benchBuilds[2];
+//----------------------------------------------------------------------------
 
-  static F32 error0 = 0.0f;
-  F32 target, error;
-  S32 dms;
-  if (elap > Vid::renderState.mrmLow)
-  {
-    // too slow
-    dms = elap - S32(Vid::renderState.mrmLow);
-    target = F32(dms) * 0.4f;
-    error = error0 + (target - error0) * Vid::renderState.mrmAutoConstant1;
-  }
-  else if (elap < Vid::renderState.mrmHigh)
-  {
-    // too fast
-    dms = elap - S32(Vid::renderState.mrmHigh);
-    target = F32(dms) * 0.4f;
-    error = error0 + (target - error0) * Vid::renderState.mrmAutoConstant1;
-  }
-  else
+// the order of opaque ents doesn't matter; translucent ones are z sorted by the buckets
+//
+void Mesh::Manager::SortInstances( MeshEnt ** list, U32 count)
+{
+  if (*Vid::Var::doInstance && count > 1)
   {
-    // in bounds; slowly adjust to mrmElapFrame
-    dms = elap - S32(Vid::renderState.mrmLow);
-    target = F32(dms) * 0.4f;
-    error = error0 + (target - error0) * Vid::renderState.status.mrmAutoConstant2 * target * 0.5f;
-//    error = error0 + (target - error0) * *Vid::renderState.status.mrmAutoConstant2;
+    qsort( (void *) list, (size_t) count, sizeof(MeshEnt *), CompareInstance);
   }
-//  F32 error = error0 + (target - error0) * (abs(dms) > *Vid::renderState.status.mrmAutoCutoff ? Vid::renderState.mrmAutoConstant1 : *Vid::renderState.status.mrmAutoConstant2 * target);
-#endif
+  instanceEnts  = count;
+  instanceStart = Clock::Time::UsLwr();
+}
+//----------------------------------------------------------------------------
 
-  error0 = error;
+// call after the ents passed to SortInstances have been rendered
+//
+void Mesh::Manager::InstancesDone()
+{
+  U32 us = Clock::Time::UsLwr() - instanceStart;
 
-  error *= Vid::renderState.mrmAutoConstant3;
+  U32 builds, shared;
+  MeshRoot::InstanceStats( builds, shared);
 
-  if (error <= -1.0f)
+  PERF_COUNT("Mesh ents", instanceEnts, 0)
+  PERF_COUNT("Mesh ent us", us, 0)
+  PERF_COUNT("Mesh stream builds", builds, 0)
+  PERF_COUNT("Mesh stream shared", shared, 0)
+
+  if (!benchFrames)
   {
-    error = -0.99999999999f;
+    return;
   }
-  else if (error > 9.0f)
+
+  U32 on = *Vid::Var::doInstance ? 1 : 0;
+  benchUs[on]     += us;
+  benchEnts[on]   += instanceEnts;
+  benchBuilds[on] += builds;
+
+  if (++benchFrame < benchFrames)
   {
-    error = 9.0f;
+    return;
   }
-  Vid::renderState.mrmAutoFactor = error + 1.0f;
-
-//  MSWRITEV(22, (4, 0, "dv: %d, mrm error: %f, target: %f", dv, error, target) );
+  benchFrame = 0;
 
-//  LOG_DIAG( ("elap: %d, dms: %d, error: %f, target: %f", elap, dms, error, target) );
-}
-//----------------------------------------------------------------------------
+  if (on)
+  {
+    // second half without shared streams
+    Vid::Var::doInstance = FALSE;
+    return;
+  }
 
-void Mesh::Manager::OnModeChange()
-{
-  if (sysInit)
+  for (on = 0; on < 2; on++)
   {
-    SetupRenderProcList();
+    CON_DIAG( ("instance %s: %6d us/frame %5d ents/frame %5d stream builds/frame", on ? "on " : "off",
+      benchUs[on] / benchFrames, benchEnts[on] / benchFrames, benchBuilds[on] / benchFrames) );
+    LOG_DIAG( ("instance %s: %6d us/frame %5d ents/frame %5d stream builds/frame", on ? "on " : "off",
+      benchUs[on] / benchFrames, benchEnts[on] / benchFrames, benchBuilds[on] / benchFrames) );
   }
+  Vid::Var::doInstance = benchRestore;
+  benchFrames = 0;
 }
 //----------------------------------------------------------------------------
 
-void Mesh::Manager::MakeName( BuffString &buff, const char *meshName, F32 scale) // = 1.0f)
+// render 'frames' frames with shared streams and 'frames' without, then report
+// the average ent render pass time of each; the camera should stay put
+//
+void Mesh::Manager::BenchInstances( U32 frames)
 {
-  FileDrive drive;
-  FileDir dir;
-  FileName name;
-  FileExt ext;
+  if (benchFrames)
+  {
+    // restore the setting of the run in progress
+    Vid::Var::doInstance = benchRestore;
+  }
+  benchRestore = *Vid::Var::doInstance;
+  benchFrames  = frames;
+  benchFrame   = 0;
 
-  Dir::PathExpand( meshName, drive, dir, name, ext);
+  Utils::Memset( benchUs,     0, sizeof( benchUs));
+  Utils::Memset( benchEnts,   0, sizeof( benchEnts));
+  Utils::Memset( benchBuilds, 0, sizeof( benchBuilds));
 
-  buff = meshName;
-  char *str = buff.str + Utils::Strlen(buff.str);
-  sprintf( str, " %4.4f", scale);
+  Vid::Var::doInstance = TRUE;
 }
 //----------------------------------------------------------------------------
 
@@ -462,6 +501,14 @@ void Mesh::Manager::SetupPerf()
 
   Vid::renderState.mrmFactor2 = 1.0f / perf;
 
+  // the governor can only lower shadow detail
+  //
+  SetupShadowPerf( perf * Vid::Governor::ShadowLevel());
+}
+//----------------------------------------------------------------------------
+
+void Mesh::Manager::SetupShadowPerf( F32 perf)
+{
   Vid::renderState.status.shadowType  = perf <= .8f  ? Vid::renderState.status.shadowType <= .5 ? MeshRoot::shadowOVAL : MeshRoot::shadowGENERIC : MeshRoot::shadowSEMILIVE;
   Vid::renderState.status.showShadows = perf <= .25f ? FALSE : TRUE;
 }
@@ -2044,7 +2044,7 @@ static int _cdecl CompareFaces(const void *e1, const void *e2)
 }
 //----------------------------------------------------------------------------
 
-MeshRoot *Mesh::Manager::FindRead(const char *meshName, F32 scale, Bool mrmGen, const char *fileName) // = NULL
+MeshRoot *Mesh::Manager::FindRead(const char *meshName, F32 scale, Bool mrmGen, const char *fileName, U32 cacheKey) // = NULL, = 0
 {
 	if (!meshName)
 	{
@@ -2070,6 +2070,12 @@ MeshRoot *Mesh::Manager::FindRead(const char *meshName, F32 scale, Bool mrmGen,
   }
 #endif
 
+  if (!root && cacheKey && Vid::Var::doLoadCache)
+  {
+    // a previous import of the same source and settings
+    root = FindCache( meshName, fileName, cacheKey);
+  }
+
   if (!root)
   {
   	// load the mesh
@@ -2929,12 +2929,6 @@ namespace MeshView
           selMesh->nextVertCount = count;
 //          selMesh->MRMSetVertCount( count);
         }
-        else
-        {
-          // update auto mrm error factor
-          //
-  //        Mesh::Manager::UpdateMRMFactor();
-        }
 
   //      MSWRITEV(22, (0, 5, "mrmFactor %f, vertCount %d", 
   //        *Vid::renderState.mrmFactor1, root.vertCount));
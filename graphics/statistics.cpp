@@ -41,6 +41,9 @@ namespace Statistics
 
     VarInteger clipTris;
     VarInteger noClipTris;
+
+    VarInteger drawCalls;
+    VarInteger stateChanges;
   };
 
   U32 terrainTris;
@@ -59,6 +62,9 @@ namespace Statistics
   U32 clipTris;
   U32 noClipTris;
 
+  U32 drawCalls;
+  U32 stateChanges;
+
   // used to gather tri data from low level routines
   U32 tempTris;
 
@@ -94,6 +100,9 @@ namespace Statistics
     clipTris = 0;
     noClipTris = 0;
 
+    drawCalls = 0;
+    stateChanges = 0;
+
     tempTris = 0;
   }
 
@@ -108,6 +117,8 @@ namespace Statistics
     Var::nonMRMTris       = nonMRMTris;
     Var::clipTris         = clipTris;
     Var::noClipTris       = noClipTris;
+    Var::drawCalls        = drawCalls;
+    Var::stateChanges     = stateChanges;
 
     totalTris = terrainTris + spriteTris + groundSpriteTris + objectTris + overlayTris + ifaceTris;
   }
@@ -135,6 +146,7 @@ namespace Statistics
 
     VarSys::RegisterHandler("statistics", CmdHandler);
     VarSys::RegisterHandler("statistics.tris", CmdHandler);
+    VarSys::RegisterHandler("statistics.draw", CmdHandler);
 
     // Statistics vars
     VarSys::CreateInteger("statistics.tris.terrain", 0, VarSys::DEFAULT, &Statistics::Var::terrainTris);
@@ -153,6 +165,9 @@ namespace Statistics
     VarSys::CreateInteger("statistics.tris.clip",   0, VarSys::DEFAULT, &Statistics::Var::clipTris);
     VarSys::CreateInteger("statistics.tris.noclip", 0, VarSys::DEFAULT, &Statistics::Var::noClipTris);
 
+    VarSys::CreateInteger("statistics.draw.calls",  0, VarSys::DEFAULT, &Statistics::Var::drawCalls);
+    VarSys::CreateInteger("statistics.draw.states", 0, VarSys::DEFAULT, &Statistics::Var::stateChanges);
+
     initialized = TRUE;
   }
 
@@ -168,6 +183,7 @@ namespace Statistics
 
     // Delete the scope
     VarSys::DeleteItem("statistics.tris");
+    VarSys::DeleteItem("statistics.draw");
     VarSys::DeleteItem("statistics");
 
     initialized = FALSE;
@@ -38,6 +38,9 @@ namespace Statistics
   extern U32 clipTris;
   extern U32 noClipTris;
 
+  extern U32 drawCalls;
+  extern U32 stateChanges;   // texture and material switches
+
   // used to gather tri data from low level routines
   extern U32 tempTris;
 
@@ -17,6 +17,7 @@
 #include "terrain_priv.h"
 #include "random.h"
 #include "console.h"
+#include "system.h"
 //----------------------------------------------------------------------------
 
 #define DOVERTCOLORS
@@ -224,6 +225,15 @@ namespace Terrain
   void CalcSpheres();
 	void CalcNormals();
 	void CalcNormalsQuick();
+
+  // a rect of cells for CalcNormalBand
+  //
+  struct NormalBand
+  {
+    S32             x0, z0, x1, z1;     // exclusive max
+    F32             sum, min, max;      // heights
+  };
+  void CalcNormalBand( NormalBand & band);
   //----------------------------------------------------------------------------
 
   Bool SetTexClamp( Bool clamp) // = TRUE
@@ -464,6 +474,8 @@ namespace Terrain
     VarSys::CreateFloat("terrain.perf.minfar", 180.0f, VarSys::DEFAULT, &Vid::Var::Terrain::minFarPlane)->SetFloatRange( 0, 500);
     VarSys::CreateFloat("terrain.perf.far", 350.0f, VarSys::DEFAULT, &Vid::Var::Terrain::standardFarPlane)->SetFloatRange( 0, 600);
     VarSys::CreateInteger("terrain.perf.clustercells", 0, VarSys::NOTIFY, &Vid::Var::Terrain::clusterCells)->SetIntegerRange( 0, 1);
+    VarSys::CreateInteger("terrain.perf.geocache", 1, VarSys::DEFAULT, &Vid::Var::Terrain::geoCache);
+    VarSys::CreateInteger("terrain.perf.normalthreads", 3, VarSys::DEFAULT, &Vid::Var::Terrain::normalThreads)->SetIntegerRange( 0, 8);
 
     VarSys::CreateInteger("terrain.shroud.active", 1, VarSys::NOEDIT, &Vid::Var::Terrain::shroud);
     VarSys::CreateInteger("terrain.shroud.invisible", 0, VarSys::NOTIFY, &Vid::Var::Terrain::invisibleShroud);
@@ -568,6 +580,9 @@ namespace Terrain
 
     randomField.Release();
 
+    Pyramid::Release();
+    Geo::Release();
+
     waterList.Release();
     waterCount = 0;
 
@@ -733,13 +748,7 @@ namespace Terrain
     }
     // editing heights: recalc cell normals and cluster bounding spheres
 
-    // adjacent cells are affected: increase rect bounds by 1
-    Area<S32> drect = dstRect;
-    drect.p0.x -= 1;
-    drect.p1.x += 1;
-    drect.p0.y -= 1;
-    drect.p1.y += 1;
-
+    // CalcCellRect adds the adjacent cells
     CalcCellRect( dstRect);
   }
   //----------------------------------------------------------------------------
@@ -1352,6 +1361,8 @@ namespace Terrain
     lowWaterHeight = F32_MAX;
     CalcSpheres();
     CalcNormals();
+    Pyramid::Build();
+    Geo::Build();
   }
   //----------------------------------------------------------------------------
 
@@ -1359,56 +1370,25 @@ namespace Terrain
   //
   void CalcCellRect( const Area<S32> &rect)
   {
-    Area<S32> drect = rect;
+    // a cell's normal depends on its neighbours' heights: add a one cell border
+    NormalBand band;
+    band.x0 = Max<S32>( 0, Min<S32>( rect.p0.x, rect.p1.x) - 1);
+    band.z0 = Max<S32>( 0, Min<S32>( rect.p0.y, rect.p1.y) - 1);
+    band.x1 = Min<S32>( heightField.cellPitch,  Max<S32>( rect.p0.x, rect.p1.x) + 2);
+    band.z1 = Min<S32>( heightField.cellHeight, Max<S32>( rect.p0.y, rect.p1.y) + 2);
 
-    // clip rectangle to leave edge cell normals alone
-    // CalcCellNormal expects to access cell - 1, cell + 1, cell - cellWidth, cell + cellWidth
-    if (drect.p0.x <= 0)
+    if (band.x0 < band.x1 && band.z0 < band.z1)
     {
-      drect.p0.x = 1;
-    }
-    if (drect.p1.x >= (S32) (heightField.cellWidth - 1))
-    {
-      drect.p1.x = heightField.cellWidth - 2;
-    }
-    if (drect.p0.y <= 0)
-    {
-      drect.p0.y = 1;
-    }
-    if (drect.p1.y >= (S32) (heightField.cellHeight - 1))
-    {
-      drect.p1.y = heightField.cellHeight - 2;
-    }
+      CalcNormalBand( band);
 
-    S32 z, x;  // cells
-    for (z = drect.p0.y; z < drect.p1.y; z++)
-    {
-      x = rect.p0.x;
-      U32 offset = z * heightField.cellPitch + x;
-      for (x = drect.p0.x; x < drect.p1.x; x++, offset++)
-      {
-        Cell &cell = heightField.cellList[ offset];
-  #define DODYNAMICNORMALS2
-  #ifdef DODYNAMICNORMALS1
-        cell.normal = (U8) heightField.CalcCellNormalQuick( offset);
-  #endif
-  #ifdef DODYNAMICNORMALS2
-        cell.normal = (U8) heightField.CalcCellNormal( offset);
-  #endif
-
-        if (cell.height < terrMinHeight)
-        {
-          terrMinHeight = cell.height ;
-        }
-        if (cell.height  > terrMaxHeight)
-        {
-          terrMaxHeight = cell.height ;
-        }
-      }
+      terrMinHeight = Min<F32>( terrMinHeight, band.min);
+      terrMaxHeight = Max<F32>( terrMaxHeight, band.max);
     }
 
+    S32 z, x;
+
     // calc cluster bounding rect
-    drect = rect;
+    Area<S32> drect = rect;
     drect.p0.x >>= cellPerClusShift;
     drect.p1.x >>= cellPerClusShift;
     drect.p0.y >>= cellPerClusShift;
@@ -1449,6 +1429,9 @@ namespace Terrain
         CalcClusSphere( x, z);
       }
     }
+    Pyramid::Update( rect);
+    Geo::Update( Area<S32>( band.x0, band.z0, band.x1, band.z1));
+
     qsort( (void *) waterList.data, (size_t) waterCount, sizeof( WaterRegion), CompareWaterRegions);
 
 #if 0
@@ -2269,6 +2252,9 @@ namespace Terrain
       }
     }
   #endif
+
+    // cached cluster normals come from the list
+    Geo::Invalidate();
   }
   //----------------------------------------------------------------------------
 
@@ -2375,58 +2361,103 @@ namespace Terrain
   }
   //----------------------------------------------------------------------------
 
-  // recalculate all the cells' normal indices in terrain
+  // recalculate the normal indices of a rect of cells; exclusive max
+  // also gathers the rect's height sum and range
   //
-  void CalcNormals()
+  void CalcNormalBand( NormalBand & band)
   {
-    terrAverageHeight = 0.0f;
-    terrMinHeight =  1000000.0f;
-    terrMaxHeight = -1000000.0f;
+    band.sum = 0.0f;
+    band.min =  1000000.0f;
+    band.max = -1000000.0f;
 
-    U32 offset, cx, cz;
-    for (offset = 0, cz = 0; cz < heightField.cellHeight; cz++)
+    for (S32 cz = band.z0; cz < band.z1; cz++)
     {
-      for (cx = 0; cx < heightField.cellPitch; cx++, offset++)
+      U32 offset = cz * heightField.cellPitch + band.x0;
+      for (S32 cx = band.x0; cx < band.x1; cx++, offset++)
       {
         // edge cells get the default normal
         U32 normIndex = 0;
-        if (cx > 0 && cx < heightField.cellPitch  - 1
-         && cz > 0 && cz < heightField.cellHeight - 1)
+        if (cx > 0 && cx < (S32) heightField.cellPitch  - 1
+         && cz > 0 && cz < (S32) heightField.cellHeight - 1)
         {
           Vector norm;
           heightField.CalcCellNormal( offset, norm);
 
-          F32 maxdiff = F32_MAX;
-          U32 i;
-          for (i = 0; i < normCount; i++)
-          {
-            F32 diff = (F32) fabs( norm.x - normList[i].x);
-            diff +=    (F32) fabs( norm.y - normList[i].y);
-            diff +=    (F32) fabs( norm.z - normList[i].z);
-
-            if (diff < maxdiff)
-            {
-              maxdiff = diff;
-              normIndex = i;
-            }
-          }
+          normIndex = FindNormal( norm);
         }
         heightField.cellList[offset].normal = (U8) normIndex;
 
         F32 h = heightField.cellList[offset].height; 
 
-        terrAverageHeight += h;
+        band.sum += h;
 
-        if (h < terrMinHeight)
+        if (h < band.min)
         {
-          terrMinHeight = h;
+          band.min = h;
         }
-        if (h > terrMaxHeight)
+        if (h > band.max)
         {
-          terrMaxHeight = h;
+          band.max = h;
         }
       }
     }
+  }
+  //----------------------------------------------------------------------------
+
+  static U32 STDCALL CalcNormalProc( void * context)
+  {
+    CalcNormalBand( *(NormalBand *) context);
+
+    return 0;
+  }
+  //----------------------------------------------------------------------------
+
+  // recalculate all the cells' normal indices in terrain
+  // big maps are split into bands of rows across 'terrain.perf.normalthreads' threads
+  //
+  void CalcNormals()
+  {
+    const U32 MAXNORMALTHREADS = 8;
+    const U32 MINBANDROWS      = 32;
+
+    U32 threads = Min<U32>( *Vid::Var::Terrain::normalThreads, MAXNORMALTHREADS);
+    threads = Min<U32>( threads, heightField.cellHeight / MINBANDROWS);
+
+    NormalBand bands[MAXNORMALTHREADS + 1];
+    System::Thread * workers[MAXNORMALTHREADS];
+
+    U32 rows = heightField.cellHeight / (threads + 1), i;
+    for (i = 0; i <= threads; i++)
+    {
+      bands[i].x0 = 0;
+      bands[i].x1 = heightField.cellPitch;
+      bands[i].z0 = i * rows;
+      bands[i].z1 = i == threads ? heightField.cellHeight : (i + 1) * rows;
+    }
+
+    // the last band is done here
+    for (i = 0; i < threads; i++)
+    {
+      workers[i] = new System::Thread( CalcNormalProc, &bands[i]);
+    }
+    CalcNormalBand( bands[threads]);
+
+    terrAverageHeight = 0.0f;
+    terrMinHeight =  1000000.0f;
+    terrMaxHeight = -1000000.0f;
+
+    for (i = 0; i <= threads; i++)
+    {
+      if (i < threads)
+      {
+        // waits for the thread to exit
+        delete workers[i];
+      }
+      terrAverageHeight += bands[i].sum;
+      terrMinHeight = Min<F32>( terrMinHeight, bands[i].min);
+      terrMaxHeight = Max<F32>( terrMaxHeight, bands[i].max);
+    }
+
     if (terrMaxHeight < terrMinHeight + 100.0f)
     {
       terrMaxHeight = terrMinHeight + 100.0f;
@@ -2724,6 +2755,8 @@ namespace Terrain
 
         return TRUE;
       }
+      // jump over steps that are known to pass above the terrain
+      pos += front * (F32) Pyramid::SkipSteps( pos, front, max);
       pos += front;
 
       if (!MeterOnMap( pos.x, pos.z) || pos.y > max)
@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1997-2000 Pandemic Studios, Dark Reign II
+//
+// terrain_geo.cpp     cached full detail cluster geometry
+//
+// 19-OCT-2026
+//
+
+#include "vid_private.h"
+#include "terrain_priv.h"
+//----------------------------------------------------------------------------
+
+namespace Terrain
+{
+  namespace Geo
+  {
+    static Array<ClusterGeo>    geos;
+    //----------------------------------------------------------------------------
+
+    void Release()
+    {
+      geos.Release();
+    }
+    //----------------------------------------------------------------------------
+
+    // allocate an entry per cluster; they fill as clusters are drawn
+    //
+    void Build()
+    {
+      Release();
+
+      if (!clusList || !clusWidth || !clusHeight)
+      {
+        return;
+      }
+      geos.Alloc( clusWidth * clusHeight);
+
+      Invalidate();
+    }
+    //----------------------------------------------------------------------------
+
+    void Invalidate()
+    {
+      for (U32 i = 0; i < geos.count; i++)
+      {
+        geos[i].valid = FALSE;
+      }
+    }
+    //----------------------------------------------------------------------------
+
+    // drop the clusters touching the cell rect
+    //
+    void Update( const Area<S32> & rect)
+    {
+      if (!geos.data)
+      {
+        return;
+      }
+
+      // cells on a cluster's left/top edge are also the previous cluster's last verts
+      S32 x0 = Max<S32>( 0, (Min<S32>( rect.p0.x, rect.p1.x) - 1) >> cellPerClusShift);
+      S32 z0 = Max<S32>( 0, (Min<S32>( rect.p0.y, rect.p1.y) - 1) >> cellPerClusShift);
+      S32 x1 = Min<S32>( clusWidth  - 1, Max<S32>( rect.p0.x, rect.p1.x) >> cellPerClusShift);
+      S32 z1 = Min<S32>( clusHeight - 1, Max<S32>( rect.p0.y, rect.p1.y) >> cellPerClusShift);
+
+      for (S32 z = z0; z <= z1; z++)
+      {
+        for (S32 x = x0; x <= x1; x++)
+        {
+          geos[z * clusWidth + x].valid = FALSE;
+        }
+      }
+    }
+    //----------------------------------------------------------------------------
+
+    // positions, normals and cell planes for a cluster drawn at x, z meters
+    // returns NULL if there's no cache for the current map
+    //
+    ClusterGeo * Get( Cluster & clus, S32 x, S32 z, U32 cellOffset)
+    {
+      if (!geos.data || !*Vid::Var::Terrain::geoCache)
+      {
+        return NULL;
+      }
+      ASSERT( &clus >= clusList && &clus < clusList + geos.count);
+
+      ClusterGeo & geo = geos[&clus - clusList];
+
+      if (geo.valid && geo.x == x && geo.z == z)
+      {
+        return &geo;
+      }
+      geo.x = x;
+      geo.z = z;
+      geo.valid = TRUE;
+
+      S32 meterStride = heightField.meterPerCell;
+      S32 x0, xend = x + meterPerClus;
+      S32 z0, zend = z + meterPerClus;
+
+      Cell * c0 = &heightField.cellList[cellOffset];
+
+      Vector * dv = geo.verts, * dn = geo.norms;
+      for (z0 = z; z0 <= zend; z0 += meterStride, c0 += heightField.cellPitch)
+      {
+        Cell * c = c0;
+        for (x0 = x; x0 <= xend; x0 += meterStride, dv++, dn++, c++)
+        {
+          dv->x = (F32) x0;
+          dv->z = (F32) z0;
+          dv->y = c->height;
+
+          *dn = normList[c->normal];
+        }
+      }
+
+      // 0*\--*3
+      //  | \ |
+      // 1*--\*2
+      //
+      Plane * dp = geo.planes;
+      for (U32 i = 0; i < 24; i++)
+      {
+        if (i % 5 == 4)
+        {
+          // last vert in the row
+          continue;
+        }
+        dp[0].Set( geo.verts[i], geo.verts[i + 5], geo.verts[i + 6]);
+        dp[1].Set( geo.verts[i], geo.verts[i + 6], geo.verts[i + 1]);
+        dp += 2;
+      }
+      ASSERT( dp == geo.planes + 32);
+
+      return &geo;
+    }
+    //----------------------------------------------------------------------------
+  }
+}
+//----------------------------------------------------------------------------
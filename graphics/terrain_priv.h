@@ -305,6 +305,50 @@ namespace Terrain
 
   typedef F32 (*FINDFLOORPROCPTR)( F32 x, F32 z, Vector * surfNormal = NULL);
 
+  typedef void (*CELLHEIGHTSPROCPTR)( U32 cx, U32 cz, F32 * heights);
+
+  // max height mip pyramid over the clusters; includes water
+  // lets ray casts skip over empty space
+  //
+  namespace Pyramid
+  {
+    void Build();
+    void Release();
+    void Update( const Area<S32> & rect);   // cell coords
+
+    // override the heights used for the leaves, i.e. footprinted layers
+    void SetCellHeightsProc( CELLHEIGHTSPROCPTR proc);
+
+    U32  LevelCount();
+    F32  MaxHeight( U32 level, S32 bx, S32 bz);
+    F32  MaxHeight( S32 cx0, S32 cz0, S32 cx1, S32 cz1);   // inclusive cell rect
+
+    // steps of 'step' from 'pos' that are certain to stay over empty space
+    U32  SkipSteps( const Vector & pos, const Vector & step, F32 ceiling);
+  }
+
+  // full detail geometry for a cluster; rebuilt only after height or normal edits
+  //
+  struct ClusterGeo
+  {
+    Vector                verts[25];
+    Vector                norms[25];
+    Plane                 planes[32];       // two per cell, row by row
+
+    S32                   x, z;             // meter origin the verts were built at
+    Bool                  valid;
+  };
+
+  namespace Geo
+  {
+    void Build();
+    void Release();
+    void Invalidate();
+    void Update( const Area<S32> & rect);   // cell coords
+
+    ClusterGeo * Get( Cluster & clus, S32 x, S32 z, U32 cellOffset);
+  }
+
   Bool Intersect( Vector & pos, Vector front, F32 stepScale = 1.0f, const FINDFLOORPROCPTR findFloorProc = FindFloor, F32 range = F32_MAX);
   Bool ScreenToTerrain( S32 sx, S32 sy, Vector &pos, FINDFLOORPROCPTR findFloorProc = FindFloor);
 
@@ -457,6 +501,7 @@ namespace Terrain
   extern U32              texCount, overlayCount;
 
   extern U32              meterPerClus, cellPerClus; // in one dimension
+  extern U32              cellPerClusShift;
   extern Cluster          * clusList;
 
   extern S32              shroudRate1;
@@ -0,0 +1,320 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1997-2000 Pandemic Studios, Dark Reign II
+//
+// terrain_pyramid.cpp     max height pyramid for terrain ray casts
+//
+// 19-OCT-2026
+//
+
+#include "vid_private.h"
+#include "terrain_priv.h"
+//----------------------------------------------------------------------------
+
+namespace Terrain
+{
+  namespace Pyramid
+  {
+    const U32 MAXLEVELS = 16;
+
+    // level 0 holds one entry per cluster; each level above halves both dimensions
+    //
+    static Array<F32>           heights;
+    static U32                  levelCount;
+    static U32                  levelOffset[MAXLEVELS];
+    static U32                  levelWidth[MAXLEVELS];
+    static U32                  levelHeight[MAXLEVELS];
+
+    static CELLHEIGHTSPROCPTR   cellHeightsProc = NULL;
+    //----------------------------------------------------------------------------
+
+    // highest point of a single cluster, water included
+    //
+    static F32 CalcLeaf( U32 x, U32 z)
+    {
+      Cluster & clus = clusList[ z * clusWidth + x];
+
+      F32 top = clus.status.water ? clus.waterHeight : -F32_MAX;
+
+      U32 cx0 = x << cellPerClusShift;
+      U32 cz0 = z << cellPerClusShift;
+
+      if (cellHeightsProc)
+      {
+        // the proc decides per cell which layer to use
+        F32 h[4];
+        for (U32 cz = cz0; cz < cz0 + cellPerClus; cz++)
+        {
+          for (U32 cx = cx0; cx < cx0 + cellPerClus; cx++)
+          {
+            (*cellHeightsProc)( cx, cz, h);
+
+            top = Max<F32>( top, Max<F32>( Max<F32>( h[0], h[1]), Max<F32>( h[2], h[3])));
+          }
+        }
+        return top;
+      }
+
+      // a cluster's cells share their outer row of vertices with the neighbours
+      Cell * c0 = heightField.cellList + cz0 * heightField.cellPitch + cx0, * ce0 = c0 + (cellPerClus + 1) * heightField.cellPitch;
+      for ( ; c0 < ce0; c0 += heightField.cellPitch)
+      {
+        Cell * c, * ce = c0 + cellPerClus + 1;
+        for (c = c0; c < ce; c++)
+        {
+          if (c->height > top)
+          {
+            top = c->height;
+          }
+        }
+      }
+      return top;
+    }
+    //----------------------------------------------------------------------------
+
+    void Release()
+    {
+      heights.Release();
+      levelCount = 0;
+    }
+    //----------------------------------------------------------------------------
+
+    // allocate the levels for the current map and fill them
+    //
+    void Build()
+    {
+      Release();
+
+      if (!clusList || !clusWidth || !clusHeight)
+      {
+        return;
+      }
+
+      U32 w = clusWidth, h = clusHeight, total = 0;
+      for (levelCount = 0; levelCount < MAXLEVELS; )
+      {
+        levelOffset[levelCount] = total;
+        levelWidth[levelCount]  = w;
+        levelHeight[levelCount] = h;
+        levelCount++;
+
+        total += w * h;
+
+        if (w == 1 && h == 1)
+        {
+          break;
+        }
+        w = (w + 1) >> 1;
+        h = (h + 1) >> 1;
+      }
+      heights.Alloc( total);
+
+      Update( Area<S32>( 0, 0, clusWidth << cellPerClusShift, clusHeight << cellPerClusShift));
+    }
+    //----------------------------------------------------------------------------
+
+    // recalc the leaves touching the cell rect and propagate up
+    //
+    void Update( const Area<S32> & rect)
+    {
+      if (!heights.data)
+      {
+        return;
+      }
+
+      // cells on a cluster's left/top edge share vertices with the previous cluster
+      S32 x0 = Max<S32>( 0, (Min<S32>( rect.p0.x, rect.p1.x) - 1) >> cellPerClusShift);
+      S32 z0 = Max<S32>( 0, (Min<S32>( rect.p0.y, rect.p1.y) - 1) >> cellPerClusShift);
+      S32 x1 = Min<S32>( clusWidth  - 1, Max<S32>( rect.p0.x, rect.p1.x) >> cellPerClusShift);
+      S32 z1 = Min<S32>( clusHeight - 1, Max<S32>( rect.p0.y, rect.p1.y) >> cellPerClusShift);
+
+      if (x0 > x1 || z0 > z1)
+      {
+        return;
+      }
+
+      S32 x, z;
+      for (z = z0; z <= z1; z++)
+      {
+        F32 * dst = heights.data + z * clusWidth;
+        for (x = x0; x <= x1; x++)
+        {
+          dst[x] = CalcLeaf( x, z);
+        }
+      }
+
+      for (U32 level = 1; level < levelCount; level++)
+      {
+        x0 >>= 1;
+        z0 >>= 1;
+        x1 >>= 1;
+        z1 >>= 1;
+
+        U32 sw = levelWidth[level - 1], sh = levelHeight[level - 1];
+        F32 * src = heights.data + levelOffset[level - 1];
+        F32 * dst = heights.data + levelOffset[level];
+
+        for (z = z0; z <= z1; z++)
+        {
+          U32 sz0 = z << 1, sz1 = Min<U32>( sz0 + 1, sh - 1);
+
+          for (x = x0; x <= x1; x++)
+          {
+            U32 sx0 = x << 1, sx1 = Min<U32>( sx0 + 1, sw - 1);
+
+            dst[z * levelWidth[level] + x] = Max<F32>(
+              Max<F32>( src[sz0 * sw + sx0], src[sz0 * sw + sx1]),
+              Max<F32>( src[sz1 * sw + sx0], src[sz1 * sw + sx1]));
+          }
+        }
+      }
+    }
+    //----------------------------------------------------------------------------
+
+    void SetCellHeightsProc( CELLHEIGHTSPROCPTR proc)
+    {
+      cellHeightsProc = proc;
+
+      if (heights.data)
+      {
+        Update( Area<S32>( 0, 0, clusWidth << cellPerClusShift, clusHeight << cellPerClusShift));
+      }
+    }
+    //----------------------------------------------------------------------------
+
+    U32 LevelCount()
+    {
+      return levelCount;
+    }
+    //----------------------------------------------------------------------------
+
+    F32 MaxHeight( U32 level, S32 bx, S32 bz)
+    {
+      ASSERT( level < levelCount);
+      ASSERT( bx >= 0 && bx < (S32) levelWidth[level] && bz >= 0 && bz < (S32) levelHeight[level]);
+
+      return heights.data[levelOffset[level] + bz * levelWidth[level] + bx];
+    }
+    //----------------------------------------------------------------------------
+
+    // conservative max height over an inclusive cell rect
+    // reads at most 2 x 2 entries from the smallest level that covers the rect
+    //
+    F32 MaxHeight( S32 cx0, S32 cz0, S32 cx1, S32 cz1)
+    {
+      if (!heights.data)
+      {
+        return F32_MAX;
+      }
+
+      S32 x0 = Max<S32>( 0, cx0 >> cellPerClusShift);
+      S32 z0 = Max<S32>( 0, cz0 >> cellPerClusShift);
+      S32 x1 = Min<S32>( clusWidth  - 1, cx1 >> cellPerClusShift);
+      S32 z1 = Min<S32>( clusHeight - 1, cz1 >> cellPerClusShift);
+
+      if (x0 > x1 || z0 > z1)
+      {
+        // entirely off map
+        return offMapHeight;
+      }
+
+      U32 level = 0;
+      while (level + 1 < levelCount && (x1 - x0 > 1 || z1 - z0 > 1))
+      {
+        level++;
+        x0 >>= 1;
+        z0 >>= 1;
+        x1 >>= 1;
+        z1 >>= 1;
+      }
+
+      F32 top = -F32_MAX;
+      for (S32 z = z0; z <= z1; z++)
+      {
+        F32 * src = heights.data + levelOffset[level] + z * levelWidth[level];
+        for (S32 x = x0; x <= x1; x++)
+        {
+          if (src[x] > top)
+          {
+            top = src[x];
+          }
+        }
+      }
+      return top;
+    }
+    //----------------------------------------------------------------------------
+
+    // number of whole steps from 'pos' along 'step' that stay inside the largest
+    // pyramid block the position is above, and below 'ceiling'
+    // 'pos' is in meters
+    //
+    U32 SkipSteps( const Vector & pos, const Vector & step, F32 ceiling)
+    {
+      if (!heights.data)
+      {
+        return 0;
+      }
+
+      F32 x = pos.x + OffsetX();
+      F32 z = pos.z + OffsetZ();
+
+      if (x < 0.0f || z < 0.0f || x >= (F32) MeterWidth() || z >= (F32) MeterHeight())
+      {
+        return 0;
+      }
+
+      S32 bx = Min<S32>( clusWidth  - 1, (S32) (x * clusPerMeter));
+      S32 bz = Min<S32>( clusHeight - 1, (S32) (z * clusPerMeter));
+
+      // find the coarsest block that the position is above
+      //
+      for (S32 level = levelCount - 1; level >= 0; level--)
+      {
+        S32 lx = bx >> level, lz = bz >> level;
+
+        F32 top = MaxHeight( level, lx, lz);
+        if (pos.y <= top)
+        {
+          continue;
+        }
+
+        // block extents; blocks on the far edge may hang off the map
+        F32 size = (F32) (meterPerClus << level);
+        F32 x0 = (F32) lx * size, x1 = Min<F32>( x0 + size, (F32) MeterWidth());
+        F32 z0 = (F32) lz * size, z1 = Min<F32>( z0 + size, (F32) MeterHeight());
+
+        F32 t = 10000.0f;
+        if (step.x > 0.0f)
+        {
+          t = Min<F32>( t, (x1 - x) / step.x);
+        }
+        else if (step.x < 0.0f)
+        {
+          t = Min<F32>( t, (x0 - x) / step.x);
+        }
+        if (step.z > 0.0f)
+        {
+          t = Min<F32>( t, (z1 - z) / step.z);
+        }
+        else if (step.z < 0.0f)
+        {
+          t = Min<F32>( t, (z0 - z) / step.z);
+        }
+        if (step.y < 0.0f)
+        {
+          t = Min<F32>( t, (top - pos.y) / step.y);
+        }
+        else if (step.y > 0.0f)
+        {
+          t = Min<F32>( t, (ceiling - pos.y) / step.y);
+        }
+
+        // stay strictly short of the boundary
+        return t >= 2.0f ? (U32) t - 1 : 0;
+      }
+      return 0;
+    }
+    //----------------------------------------------------------------------------
+  }
+}
+//----------------------------------------------------------------------------
@@ -205,6 +205,9 @@ namespace Terrain
 
     Cell * c0 = &heightField.cellList[cellOffset];
 
+    // positions and normals only change with the heights
+    ClusterGeo * geo = cellStrideX == 1 && cellStrideZ == 1 ? Geo::Get( clus, x, z, cellOffset) : NULL;
+
     Vertex verts[25], * dv = verts;
     F32 fogs[25], * f = fogs;
     for (z0 = z; z0 <= zend; z0 += meterStrideZ, c0 += cellStrideWidth)
@@ -212,11 +215,19 @@ namespace Terrain
       Cell * c = c0;
       for (x0 = x; x0 <= xend; x0 += meterStrideX, dv++, c += cellStrideX, f++)
       {
-        dv->vv.x = (F32) x0;
-        dv->vv.z = (F32) z0;
-        dv->vv.y = c->height;
+        if (geo)
+        {
+          dv->vv = geo->verts[dv - verts];
+          dv->nv = geo->norms[dv - verts];
+        }
+        else
+        {
+          dv->vv.x = (F32) x0;
+          dv->vv.z = (F32) z0;
+          dv->vv.y = c->height;
 
-        dv->nv = normList[c->normal];
+          dv->nv = normList[c->normal];
+        }
 
 //        dv->diffuse = c->color;
         if (Vid::Var::Terrain::shroud)
@@ -313,8 +313,11 @@ namespace Terrain
 */
     Cell *c0 = &heightField.cellList[cellOffset];
 
-    Vector verts[25], * dv = verts;
-    Vector norms[25], * dn = norms;
+    // positions, normals, and cell planes only change with the heights
+    ClusterGeo * geo = cellStrideX == 1 && cellStrideZ == 1 ? Geo::Get( clus, x, z, cellOffset) : NULL;
+
+    Vector vertBuf[25], * verts = geo ? geo->verts : vertBuf, * dv = verts;
+    Vector normBuf[25], * norms = geo ? geo->norms : normBuf, * dn = norms;
     Color colors[25], * dc = colors;
     F32     fogs[25], * df = fogs;
     for (z0 = z; z0 <= zend; z0 += meterStrideZ, c0 += cellStrideWidth)
@@ -327,11 +330,14 @@ namespace Terrain
           *df = (F32) c->GetFog() * U8toNormF32;
         }
 
-        dv->x = (F32) x0;
-        dv->z = (F32) z0;
-        dv->y = c->height;
+        if (!geo)
+        {
+          dv->x = (F32) x0;
+          dv->z = (F32) z0;
+          dv->y = c->height;
 
-        *dn = normList[c->normal];
+          *dn = normList[c->normal];
+        }
 
 #ifdef DOTERRAINCOLOR
         *dc = c->color;
@@ -345,6 +351,7 @@ namespace Terrain
     // submit cells
     VertexTL tempmem[25];
     U32 vcount = dv - verts;
+    U32 cellCount;
 
 //    Bool softS    = shroud && *softShroud;
 
@@ -375,10 +382,10 @@ namespace Terrain
         }
       }
 
-      for (z0 = z, vcount = 0; z0 < zend; z0 += meterStrideZ, vcount++, c0 += cellStrideWidth)
+      for (z0 = z, vcount = 0, cellCount = 0; z0 < zend; z0 += meterStrideZ, vcount++, c0 += cellStrideWidth)
       {
         Cell *c = c0;
-        for (x0 = x; x0 < xend; x0 += meterStrideX, vcount++, c += cellStrideX)
+        for (x0 = x; x0 < xend; x0 += meterStrideX, vcount++, cellCount++, c += cellStrideX)
         {
           if ((!c->GetVisible() && c->GetFog() >= *Vid::Var::Terrain::shroudFog) /* || (isInvisS && c->GetFog() >= *Vid::Var::Terrain::shroudFog) */)
           {
@@ -396,9 +403,16 @@ namespace Terrain
           iv[2] = (U16)(vcount + 6);
           iv[3] = (U16)(vcount + 1);
 
-          Plane planes[2];
-          planes[0].Set( verts[iv[0]], verts[iv[1]], verts[iv[2]]);
-          planes[1].Set( verts[iv[0]], verts[iv[2]], verts[iv[3]]);
+          Plane planeList[2], * planes = planeList;
+          if (geo)
+          {
+            planes = geo->planes + (cellCount << 1);
+          }
+          else
+          {
+            planes[0].Set( verts[iv[0]], verts[iv[1]], verts[iv[2]]);
+            planes[1].Set( verts[iv[0]], verts[iv[2]], verts[iv[3]]);
+          }
 
           // backcull
 	  	    if (planes[0].Evalue(Vid::Math::modelViewVector) <= 0.0f
@@ -572,10 +586,10 @@ namespace Terrain
         }
       }
 
-      for (z0 = z, vcount = 0; z0 < zend; z0 += meterStrideZ, vcount++, c0 += cellStrideWidth)
+      for (z0 = z, vcount = 0, cellCount = 0; z0 < zend; z0 += meterStrideZ, vcount++, c0 += cellStrideWidth)
       {
         Cell *c = c0;
-        for (x0 = x; x0 < xend; x0 += meterStrideX, vcount++, c += cellStrideX)
+        for (x0 = x; x0 < xend; x0 += meterStrideX, vcount++, cellCount++, c += cellStrideX)
         {
           if ((!c->GetVisible() && c->GetFog() >= *Vid::Var::Terrain::shroudFog) /* || (isInvisS && c->GetFog() >= *Vid::Var::Terrain::shroudFog) */)
           {
@@ -588,9 +602,16 @@ namespace Terrain
           iv[2] = (U16)(vcount + 6);
           iv[3] = (U16)(vcount + 1);
 
-          Plane planes[2];
-          planes[0].Set( verts[iv[0]], verts[iv[1]], verts[iv[2]]);
-          planes[1].Set( verts[iv[0]], verts[iv[2]], verts[iv[3]]);
+          Plane planeList[2], * planes = planeList;
+          if (geo)
+          {
+            planes = geo->planes + (cellCount << 1);
+          }
+          else
+          {
+            planes[0].Set( verts[iv[0]], verts[iv[1]], verts[iv[2]]);
+            planes[1].Set( verts[iv[0]], verts[iv[2]], verts[iv[3]]);
+          }
 
           // backcull: FIXME cull each tri separately
 	  	    if (planes[0].Evalue(Vid::Math::modelViewVector) <= 0.0f
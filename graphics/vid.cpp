@@ -238,7 +238,15 @@ namespace Vid
     theStyle = GetWindowLong( hWnd, GWL_STYLE);
 
     Vid::isStatus.fullScreen = doStatus.fullScreen;    // for initial InitDD
-    if (!InitDD() || !SetMode( curMode))
+    if (doStatus.softVid)
+    {
+      // device-less; skip dd/d3d entirely and leave isStatus.initialized
+      // clear so the render state setters don't touch the missing device
+      Vid::isStatus.softVid    = TRUE;
+      Vid::isStatus.fullScreen = FALSE;
+      LOG_DIAG( ("Vid::Init: no device, software rasterizer only %dx%d", viewRect.Width(), viewRect.Height()) );
+    }
+    else if (!InitDD() || !SetMode( curMode))
 	  {
       if (Vid::isStatus.gotDD)
       {
@@ -260,6 +268,8 @@ namespace Vid
 
     // initialize dependent systems
     Mirror::Init();
+    Soft::Init();
+    Governor::Init();
     Terrain::Init();
 
     Settings::SetupFinal();
@@ -1556,6 +1566,8 @@ namespace Vid
     DoneBuckets();
 
     Mirror::Done();
+    Soft::Done();
+    Governor::Done();
 
     Terrain::Done();
     Mesh::Manager::Done();
@@ -1650,6 +1662,12 @@ namespace Vid
   {
     Heap::Check();
 
+    if (Soft::IsActive())
+    {
+      // nothing to present; the frame stays in the soft framebuffer
+      return TRUE;
+    }
+
     if (Vid::isStatus.pageFlip)
 	  {
 /*
@@ -97,6 +97,7 @@ namespace Vid
                    
     VarInteger       waitRetrace;
     VarInteger       xmm;
+    VarInteger       lightBatch;
     VarInteger       transort;
                    
     VarInteger       clipGuard;
@@ -104,6 +105,7 @@ namespace Vid
     VarInteger       clipVis;
     VarInteger       clipBox;
     VarInteger       clipFunc;
+    VarInteger       clipBlocks;     // cull map objects by cluster block
                    
     VarInteger       checkVerts;
     VarInteger       mirrorDebug;
@@ -355,6 +357,7 @@ namespace Vid
       VarSys::CreateInteger("vid.fog",              Vid::renderState.status.fog,         VarSys::NOTIFY, &Vid::Var::varFog);
       VarSys::CreateInteger("vid.waitretrace",      Vid::renderState.status.waitRetrace, VarSys::NOTIFY, &Vid::Var::waitRetrace);
       VarSys::CreateInteger("vid.xmm",              Vid::renderState.status.xmm,         VarSys::NOTIFY, &Vid::Var::xmm);
+      VarSys::CreateInteger("vid.lightbatch",       1,                                   VarSys::DEFAULT, &Vid::Var::lightBatch);
       VarSys::CreateInteger("vid.checkverts",       Vid::renderState.status.checkVerts,  VarSys::NOTIFY, &Vid::Var::checkVerts);
       VarSys::CreateInteger("vid.transort",         tranbucket.doSort,                   VarSys::NOTIFY, &Vid::Var::transort);
 
@@ -366,6 +369,7 @@ namespace Vid
       VarSys::CreateInteger("vid.clip.visual",      0, VarSys::NOTIFY,    &Vid::Var::clipVis);
       VarSys::CreateInteger("vid.clip.func",        1, VarSys::NOTIFY,    &Vid::Var::clipFunc);
       VarSys::CreateInteger("vid.clip.box",         1, VarSys::NOTIFY,    &Vid::Var::clipBox);
+      VarSys::CreateInteger("vid.clip.blocks",      1, VarSys::DEFAULT,   &Vid::Var::clipBlocks);
 
       VarSys::CreateInteger("vid.alpha.activefar",  0, VarSys::NOTIFY, &Vid::Var::alphaFarActive);
       VarSys::CreateInteger("vid.alpha.activenear", 1, VarSys::NOTIFY, &Vid::Var::alphaNearActive);
@@ -29,6 +29,7 @@ namespace Vid
     VarInteger       doGenericMat;   // use generic 70% grey material
     VarInteger       doOptimize;
     VarInteger       doLoadGod;
+    VarInteger       doLoadCache;
                      
     VarFloat         mrmMergeThresh;
     VarFloat         mrmNormalCrease;
@@ -56,6 +57,7 @@ namespace Vid
     VarInteger       doMRM;          // use mrm
     VarInteger       doMultiWeight;  // use multi-weighting
     VarInteger       doInterpolate;  // interp between sim frames
+    VarInteger       doInstance;     // share vertex streams between like ents
                      
     VarInteger       teamColor;     
     VarInteger       baseColor;     
@@ -79,13 +81,19 @@ namespace Vid
                      
     VarFloat         animBlendTime;
     VarFloat         animBlendRate;
+    VarInteger       animSkipHidden; // don't sample keyframes for hidden ents
+    VarInteger       animBatch;      // lerp the node states of all ents in one pass
                      
     VarInteger       lightQuick;     // full bright lighting on units
     VarInteger       lightSingle;
     VarFloat         shadowY;        // limit shadow stretching
+    VarInteger       doShadowCache;  // share shadow textures between like ents
+    VarInteger       shadowCacheSize;
+    VarFloat         shadowCacheSun; // sun direction step before cached shadows rebuild
                      
     VarString        godFilePath;    // where to save god files
     VarString        gfgFilePath;    // where to save gfg files
+    VarString        cacheFilePath;  // where to save cached xsi imports
   }
 
   namespace Command
@@ -125,6 +133,7 @@ namespace Vid
 
       VarSys::CreateInteger("mesh.show.multiweight", 1, VarSys::NOTIFY, &Var::doMultiWeight);
       VarSys::CreateInteger("mesh.show.interpolation", 1, VarSys::NOTIFY, &Var::doInterpolate);
+      VarSys::CreateInteger("mesh.show.instance", 1, VarSys::DEFAULT, &Var::doInstance);
       VarSys::CreateInteger("mesh.show.bounds", 0, VarSys::NOTIFY, &Var::showBounds);
       VarSys::CreateInteger("mesh.show.normals", 0, VarSys::NOTIFY, &Var::showNormals);
       VarSys::CreateInteger("mesh.show.hardpoints", 0, VarSys::NOTIFY, &Var::showHardPoints);
@@ -144,6 +153,8 @@ namespace Vid
       VarSys::CreateInteger("mesh.color.shadowalpha", 32, VarSys::NOTIFY, &Var::shadowAlpha)->SetIntegerRange(0, 255);
 
       VarSys::CreateFloat("mesh.anim.blendtime", 10.0f, VarSys::NOTIFY, &Var::animBlendTime)->SetFloatRange(1.0F, 100.0F);
+      VarSys::CreateInteger("mesh.anim.skiphidden", 1, VarSys::DEFAULT, &Var::animSkipHidden);
+      VarSys::CreateInteger("mesh.anim.batch", 1, VarSys::DEFAULT, &Var::animBatch);
 
       VarSys::CreateInteger("mesh.mrm.active", 1, VarSys::NOTIFY, &Var::doMRM);
       VarSys::CreateFloat("mesh.mrm.factor", 1.0f, VarSys::NOTIFY, &Var::mrmFactor)->SetFloatRange(0.0F, 10.0F);
@@ -176,6 +187,7 @@ namespace Vid
     #endif
 
       VarSys::CreateInteger("mesh.load.god", 1, VarSys::NOTIFY, &Var::doLoadGod);
+      VarSys::CreateInteger("mesh.load.cache", 1, VarSys::NOTIFY, &Var::doLoadCache);
       VarSys::CreateInteger("mesh.load.defmaterial", 1, VarSys::NOTIFY, &Var::doGenericMat);
       VarSys::CreateInteger("mesh.load.basepose", 0, VarSys::NOTIFY, &Var::doBasePose);
       VarSys::CreateInteger("mesh.load.frogpose", 1, VarSys::NOTIFY, &Var::doFrogPose);
@@ -190,6 +202,9 @@ namespace Vid
       VarSys::CreateInteger("mesh.shadow.cast", 1, VarSys::NOTIFY, &Var::showShadowReal);
       VarSys::CreateFloat("mesh.shadow.y", 0.3f, VarSys::NOTIFY, &Var::shadowY)->SetFloatRange(0.12F, .5f);
       VarSys::CreateInteger("mesh.shadow.size", 64, VarSys::NOTIFY, &Var::varShadowSize)->SetIntegerRange( 16, 1024);
+      VarSys::CreateInteger("mesh.shadow.cache", 1, VarSys::NOTIFY, &Var::doShadowCache);
+      VarSys::CreateInteger("mesh.shadow.cachesize", 64, VarSys::NOTIFY, &Var::shadowCacheSize)->SetIntegerRange( 0, 512);
+      VarSys::CreateFloat("mesh.shadow.cachesun", 0.02f, VarSys::DEFAULT, &Var::shadowCacheSun)->SetFloatRange( 0.001f, 0.5f);
       VarSys::CreateFloat("mesh.shadow.fadedist",  .4f, VarSys::NOTIFY, &Var::varShadowFadeDist)->SetFloatRange(.001f, 1.0f);
       VarSys::CreateFloat("mesh.shadow.fadedepth", .3f, VarSys::NOTIFY, &Var::varShadowFadeDepth)->SetFloatRange(.1f, 1.0f);
       VarSys::CreateInteger("mesh.shadow.fadecutoff", 4, VarSys::NOTIFY, &Var::varShadowFadeCutoff);
@@ -208,9 +223,11 @@ namespace Vid
       VarSys::CreateCmd("mesh.envmap");
 
       VarSys::CreateCmd("mesh.report");
+      VarSys::CreateCmd("mesh.bench.instance");
 
       VarSys::CreateString("mesh.god.path",    ".\\packs\\default\\base\\art\\god", VarSys::NOTIFY, &Var::godFilePath);
       VarSys::CreateString("mesh.god.gfgpath", ".\\packs\\default\\base\\art\\gfg", VarSys::NOTIFY, &Var::gfgFilePath);
+      VarSys::CreateString("mesh.god.cachepath", ".\\cache\\god", VarSys::NOTIFY, &Var::cacheFilePath);
 
       // initial setup
       renderState.animBlendTime = Var::animBlendTime;
@@ -401,6 +418,11 @@ namespace Vid
         break;
       case 0xB3474136: // "mesh.shadow.size"
         renderState.texShadowSize = Var::varShadowSize;
+        MeshRoot::ClearShadowCache();
+        break;
+      case 0x887145FE: // "mesh.shadow.cache"
+      case 0x5B020250: // "mesh.shadow.cachesize"
+        MeshRoot::ClearShadowCache();
         break;
 
       case 0xAC7D07DF: // "mesh.shadow.nightcolor"
@@ -482,6 +504,13 @@ namespace Vid
         Console::GetArgString(1, s1);
         Mesh::Manager::ReportList( s1);
         break;
+      case 0x6359D431: // "mesh.bench.instance"
+      {
+        S32 frames = 100;
+        Console::GetArgInteger(1, frames);
+        Mesh::Manager::BenchInstances( Max<S32>( frames, 1));
+        break;
+      }
       case 0xAA7BD58D: // "mesh.dump.heirarchy"
         if (Mesh::Manager::curEnt)
         {
@@ -36,6 +36,8 @@ namespace Vid
       VarInteger     lightQuick;
       VarInteger     lightMap;
       VarInteger     clusterCells;       
+      VarInteger     geoCache;
+      VarInteger     normalThreads;
 
       VarInteger     invisibleShroud;
       VarInteger     softShroud;
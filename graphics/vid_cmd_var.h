@@ -258,6 +258,7 @@ namespace Vid
                      
     extern VarInteger       waitRetrace;
     extern VarInteger       xmm;
+    extern VarInteger       lightBatch;
     extern VarInteger       transort;
                      
     extern VarInteger       clipGuardSize;
@@ -265,6 +266,7 @@ namespace Vid
     extern VarInteger       clipVis;
     extern VarInteger       clipBox;
     extern VarInteger       clipFunc;
+    extern VarInteger       clipBlocks;     // cull map objects by cluster block
                      
     extern VarInteger       checkVerts;
     extern VarInteger       mirrorDebug;
@@ -294,6 +296,7 @@ namespace Vid
     extern VarInteger       doGenericMat;   // use generic 70% grey material
     extern VarInteger       doOptimize;
     extern VarInteger       doLoadGod;
+    extern VarInteger       doLoadCache;
                      
     extern VarFloat         mrmMergeThresh;
     extern VarFloat         mrmNormalCrease;
@@ -320,6 +323,7 @@ namespace Vid
     extern VarInteger       doMRM;          // use mrm
     extern VarInteger       doMultiWeight;  // use multi-weighting
     extern VarInteger       doInterpolate;  // interp between sim frames
+    extern VarInteger       doInstance;     // share vertex streams between like ents
                      
     extern VarInteger       teamColor;     
     extern VarInteger       baseColor;     
@@ -343,13 +347,19 @@ namespace Vid
     extern VarInteger       showMesh;       // draw the mesh
                      
     extern VarFloat         animBlendTime;
+    extern VarInteger       animSkipHidden; // don't sample keyframes for hidden ents
+    extern VarInteger       animBatch;      // lerp the node states of all ents in one pass
                      
     extern VarInteger       lightQuick;     // full bright lighting on units
     extern VarInteger       lightSingle;
     extern VarFloat         shadowY;        // limit shadow stretching
+    extern VarInteger       doShadowCache;  // share shadow textures between like ents
+    extern VarInteger       shadowCacheSize;
+    extern VarFloat         shadowCacheSun; // sun direction step before cached shadows rebuild
                      
     extern VarString        godFilePath;    // where to save god files
     extern VarString        gfgFilePath;    // where to save gfg files
+    extern VarString        cacheFilePath;  // where to save cached xsi imports
 
     namespace Terrain
     {
@@ -376,6 +386,8 @@ namespace Vid
       extern VarInteger     lightQuick;
       extern VarInteger     lightMap;
       extern VarInteger     clusterCells;       
+      extern VarInteger     geoCache;
+      extern VarInteger     normalThreads;
 
       extern VarInteger     invisibleShroud;
       extern VarInteger     softShroud;
@@ -348,6 +348,7 @@ namespace Vid
 		U32				       fullScreen	     : 1;
 		U32				       pageFlip		     : 1;
     U32              tripleBuf       : 1;
+    U32              softVid         : 1;    // no dd/d3d device; Vid::Soft rasterizes everything
 
     Status() 
     {
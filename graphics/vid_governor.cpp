@@ -0,0 +1,394 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1997-2000 Pandemic Studios, Dark Reign II
+//
+// vid_governor.cpp     frame time driven detail governor
+//
+// 19-OCT-2026
+//
+// Times the terrain, mesh, particle and interface stages of each displayed
+// frame and filters a per stage cost per unit of work (visible ents, live
+// particles).  From the filtered costs and the current work counts it predicts
+// the next frame and, when that falls outside target +/- hysteresis, moves the
+// mesh, terrain and particle detail levels toward the target, a rate limited
+// step per frame, expensive stages first.
+//
+// mesh level     : renderState.mrmAutoFactor, scales the mrm lod value
+// terrain level  : renderState.perfs[1] in steps; far plane, water, mirror
+// particle level : renderState.perfs[2], particle reduction
+// shadow level   : follows the mesh level in steps; shadow type and visibility
+//
+// The user's vid.perf settings are the ceiling; the governor only lowers them.
+//
+
+#include "vid_private.h"
+#include "terrain_priv.h"
+#include "console.h"
+#include "clock.h"
+//-----------------------------------------------------------------------------
+
+namespace Vid
+{
+  namespace Governor
+  {
+    // discrete levels move in steps of LEVELSTEP and only once the continuous
+    // level is LEVELHYST steps away
+    //
+    const F32 LEVELSTEP   = 0.125f;
+    const F32 LEVELHYST   = 0.75f;
+
+    // longer frames are hitches (loading, task switch) and aren't measured
+    //
+    const U32 MAXFRAMEUS  = 250000;
+
+    struct StageInfo
+    {
+      const char *              name;
+      F32                       minLevel;     // 1 = not steered
+
+      U32                       start;        // Start stamp
+      U32                       us;           // accumulated this frame
+      U32                       load, loadLast;
+
+      F32                       ms;           // filtered stage time
+      F32                       unitCost;     // filtered ms per unit at level 1
+      F32                       predict;      // ms predicted for next frame
+      F32                       level;        // continuous detail scale
+    };
+    static StageInfo            stages[stageCOUNT] =
+    {
+      { "terrain",   0.25f },
+      { "mesh",      0.10f },
+      { "particle",  0.10f },
+      { "interface", 1.00f },
+    };
+
+    static Bool                 sysInit = FALSE;
+
+    static U32                  lastUs;
+    static F32                  frameMs, fixedMs, predictMs;
+    static F32                  terrainStep = 1.0f, shadowStep = 1.0f;
+
+    static VarInteger           active;
+    static VarInteger           doLog;
+    static VarFloat             target;
+    static VarFloat             hysteresis;
+    static VarFloat             rate;
+    static VarFloat             filter;
+
+    // readouts
+    static VarFloat             varFrame;
+    static VarFloat             varPredict;
+    static VarFloat             varMesh;
+    static VarFloat             varTerrain;
+    static VarFloat             varParticle;
+    static VarFloat             varShadow;
+
+    static void CmdHandler( U32 pathCrc);
+    //-----------------------------------------------------------------------------
+
+    Bool IsActive()
+    {
+      return sysInit && *active;
+    }
+    //-----------------------------------------------------------------------------
+
+    void Start( U32 stage)
+    {
+      ASSERT( stage < stageCOUNT);
+
+      stages[stage].start = Clock::Time::UsLwr();
+    }
+    //-----------------------------------------------------------------------------
+
+    void Stop( U32 stage)
+    {
+      ASSERT( stage < stageCOUNT);
+
+      stages[stage].us += Clock::Time::UsLwr() - stages[stage].start;
+    }
+    //-----------------------------------------------------------------------------
+
+    void SetLoad( U32 stage, U32 load)
+    {
+      ASSERT( stage < stageCOUNT);
+
+      stages[stage].load = load;
+    }
+    //-----------------------------------------------------------------------------
+
+    F32 ShadowLevel()
+    {
+      return shadowStep;
+    }
+    //-----------------------------------------------------------------------------
+
+    // next frame's work; extrapolate the current trend, at most doubling
+    //
+    static F32 NextLoad( const StageInfo & stage)
+    {
+      F32 load = F32( Max<U32>( stage.load, 1));
+      F32 last = F32( Max<U32>( stage.loadLast, 1));
+
+      return Min<F32>( Max<F32>( load + (load - last), load * 0.5f), load * 2.0f);
+    }
+    //-----------------------------------------------------------------------------
+
+    // snap 'step' to the nearest LEVELSTEP multiple once 'level' is clearly past it
+    // returns TRUE if it changed
+    //
+    static Bool Quantize( F32 & step, F32 level)
+    {
+      if (level > step - LEVELSTEP * LEVELHYST && level < step + LEVELSTEP * LEVELHYST)
+      {
+        return FALSE;
+      }
+
+      F32 s = F32( Utils::FtoLNearest( level / LEVELSTEP)) * LEVELSTEP;
+      s = Min<F32>( Max<F32>( s, LEVELSTEP), 1.0f);
+
+      if (s == step)
+      {
+        return FALSE;
+      }
+      step = s;
+
+      return TRUE;
+    }
+    //-----------------------------------------------------------------------------
+
+    // push the levels into the render state
+    //
+    static void Apply()
+    {
+      renderState.mrmAutoFactor = 1.0f / stages[stageMESH].level;
+      renderState.perfs[2] = *Var::perfs[2] * stages[stagePARTICLE].level;
+
+      if (Quantize( terrainStep, stages[stageTERRAIN].level) && *doLog)
+      {
+        LOG_DIAG(( "governor: terrain step %.3f; predict %.1fms target %.1fms",
+          terrainStep, predictMs, *target));
+      }
+      F32 perf = Max<F32>( *Var::perfs[1] * terrainStep, 0.1f);
+      if (renderState.perfs[1] != perf)
+      {
+        // also catches vid.perf.terrain changes
+        renderState.perfs[1] = perf;
+        Terrain::SetupPerf();
+      }
+
+      if (Quantize( shadowStep, stages[stageMESH].level))
+      {
+        Mesh::Manager::SetupPerf();
+
+        if (*doLog)
+        {
+          LOG_DIAG(( "governor: shadow step %.3f; predict %.1fms target %.1fms",
+            shadowStep, predictMs, *target));
+        }
+      }
+    }
+    //-----------------------------------------------------------------------------
+
+    void Update()
+    {
+      U32 now = Clock::Time::UsLwr();
+      U32 frameUs = lastUs ? now - lastUs : 0;
+      lastUs = now;
+
+      U32 i;
+      if (!frameUs || frameUs > MAXFRAMEUS)
+      {
+        for (i = 0; i < stageCOUNT; i++)
+        {
+          stages[i].us = 0;
+          stages[i].loadLast = stages[i].load;
+        }
+        return;
+      }
+
+      // measure
+      //
+      F32 k = *filter;
+      F32 frame = F32( frameUs) * 0.001f;
+      frameMs += (frame - frameMs) * k;
+
+      F32 staged = 0.0f;
+      for (i = 0; i < stageCOUNT; i++)
+      {
+        StageInfo & stage = stages[i];
+
+        F32 ms = F32( stage.us) * 0.001f;
+        staged += ms;
+
+        stage.ms += (ms - stage.ms) * k;
+        stage.unitCost += (ms / (F32( Max<U32>( stage.load, 1)) * stage.level) - stage.unitCost) * k;
+      }
+      // simulation, sound, present, ...
+      fixedMs += (Max<F32>( frame - staged, 0.0f) - fixedMs) * k;
+
+      // predict the next frame at the current levels
+      //
+      F32 scalable = 0.0f;
+      predictMs = fixedMs;
+      for (i = 0; i < stageCOUNT; i++)
+      {
+        StageInfo & stage = stages[i];
+
+        stage.predict = stage.unitCost * NextLoad( stage) * stage.level;
+        predictMs += stage.predict;
+
+        if (stage.minLevel < 1.0f)
+        {
+          scalable += stage.predict;
+        }
+
+        stage.us = 0;
+        stage.loadLast = stage.load;
+      }
+
+      varFrame   = frameMs;
+      varPredict = predictMs;
+
+      if (!IsActive())
+      {
+        return;
+      }
+
+      // steer
+      //
+      if (scalable > 0.0f && (predictMs > *target + *hysteresis || predictMs < *target - *hysteresis))
+      {
+        // uniform scale that would land the steerable stages on target;
+        // each stage takes its share of it
+        F32 scale = (*target - (predictMs - scalable)) / scalable;
+
+        for (i = 0; i < stageCOUNT; i++)
+        {
+          StageInfo & stage = stages[i];
+          if (stage.minLevel >= 1.0f)
+          {
+            continue;
+          }
+
+          F32 want = stage.level * (1.0f + (scale - 1.0f) * stage.predict / scalable);
+          F32 step = Min<F32>( Max<F32>( want - stage.level, -*rate), *rate);
+
+          stage.level = Min<F32>( Max<F32>( stage.level + step, stage.minLevel), 1.0f);
+        }
+      }
+      Apply();
+
+      varMesh     = stages[stageMESH].level;
+      varTerrain  = terrainStep;
+      varParticle = stages[stagePARTICLE].level;
+      varShadow   = shadowStep;
+    }
+    //-----------------------------------------------------------------------------
+
+    void Reset()
+    {
+      for (U32 i = 0; i < stageCOUNT; i++)
+      {
+        stages[i].level = 1.0f;
+      }
+      terrainStep = shadowStep = 1.0f;
+
+      renderState.mrmAutoFactor = 1.0f;
+      renderState.perfs[1] = *Var::perfs[1];
+      renderState.perfs[2] = *Var::perfs[2];
+
+      Terrain::SetupPerf();
+      Mesh::Manager::SetupPerf();
+
+      varMesh = varTerrain = varParticle = varShadow = 1.0f;
+    }
+    //-----------------------------------------------------------------------------
+
+    void Report()
+    {
+      CON_DIAG(( "governor: %s target %.1fms frame %.1fms predict %.1fms fixed %.1fms",
+        *active ? "on" : "off", *target, frameMs, predictMs, fixedMs));
+
+      for (U32 i = 0; i < stageCOUNT; i++)
+      {
+        StageInfo & stage = stages[i];
+
+        CON_DIAG(( "  %-9s %6.2fms load %5d unit %.4fms level %.3f",
+          stage.name, stage.ms, stage.load, stage.unitCost, stage.level));
+      }
+      CON_DIAG(( "  terrain step %.3f shadow step %.3f", terrainStep, shadowStep));
+    }
+    //-----------------------------------------------------------------------------
+
+    void Init()
+    {
+      VarSys::RegisterHandler("vid.governor", CmdHandler);
+      VarSys::RegisterHandler("vid.governor.level", CmdHandler);
+
+      VarSys::CreateInteger("vid.governor.active", FALSE, VarSys::NOTIFY, &active);
+      VarSys::CreateInteger("vid.governor.log", TRUE, VarSys::DEFAULT, &doLog);
+      VarSys::CreateFloat("vid.governor.target", 33.3f, VarSys::DEFAULT, &target)->SetFloatRange(5.0f, 200.0f);
+      VarSys::CreateFloat("vid.governor.hysteresis", 2.0f, VarSys::DEFAULT, &hysteresis)->SetFloatRange(0.0f, 50.0f);
+      VarSys::CreateFloat("vid.governor.rate", 0.05f, VarSys::DEFAULT, &rate)->SetFloatRange(0.001f, 1.0f);
+      VarSys::CreateFloat("vid.governor.filter", 0.1f, VarSys::DEFAULT, &filter)->SetFloatRange(0.01f, 1.0f);
+
+      VarSys::CreateFloat("vid.governor.frame", 0.0f, VarSys::DEFAULT, &varFrame);
+      VarSys::CreateFloat("vid.governor.predict", 0.0f, VarSys::DEFAULT, &varPredict);
+      VarSys::CreateFloat("vid.governor.level.mesh", 1.0f, VarSys::DEFAULT, &varMesh);
+      VarSys::CreateFloat("vid.governor.level.terrain", 1.0f, VarSys::DEFAULT, &varTerrain);
+      VarSys::CreateFloat("vid.governor.level.particle", 1.0f, VarSys::DEFAULT, &varParticle);
+      VarSys::CreateFloat("vid.governor.level.shadow", 1.0f, VarSys::DEFAULT, &varShadow);
+
+      VarSys::CreateCmd("vid.governor.report");
+
+      for (U32 i = 0; i < stageCOUNT; i++)
+      {
+        StageInfo & stage = stages[i];
+
+        stage.us = stage.load = stage.loadLast = 0;
+        stage.ms = stage.unitCost = stage.predict = 0.0f;
+        stage.level = 1.0f;
+      }
+      terrainStep = shadowStep = 1.0f;
+
+      lastUs = 0;
+      frameMs = fixedMs = predictMs = 0.0f;
+
+      sysInit = TRUE;
+    }
+    //-----------------------------------------------------------------------------
+
+    void Done()
+    {
+      if (!sysInit)
+      {
+        return;
+      }
+
+      VarSys::DeleteItem("vid.governor");
+
+      sysInit = FALSE;
+    }
+    //-----------------------------------------------------------------------------
+
+    static void CmdHandler( U32 pathCrc)
+    {
+      switch (pathCrc)
+      {
+      case 0x3BE6FE19: // "vid.governor.active"
+        if (!*active)
+        {
+          Reset();
+        }
+        break;
+
+      case 0x67E32F46: // "vid.governor.report"
+        Report();
+        break;
+      }
+    }
+    //-----------------------------------------------------------------------------
+  }
+}
+//-----------------------------------------------------------------------------
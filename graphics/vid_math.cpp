@@ -117,8 +117,11 @@ namespace Vid
 
   void SetWorldTransform_D3D( const Matrix &mat )
   {
-	  dxError = device->SetTransform( D3DTRANSFORMSTATE_WORLD, (D3DMATRIX*) &mat );
-	  LOG_DXERR( ("device->SetTransform: world") );
+    if (device)
+    {
+	    dxError = device->SetTransform( D3DTRANSFORMSTATE_WORLD, (D3DMATRIX*) &mat );
+	    LOG_DXERR( ("device->SetTransform: world") );
+    }
   }
   //----------------------------------------------------------------------------
 
@@ -138,8 +141,11 @@ namespace Vid
 
   void SetViewTransform_D3D( const Matrix & mat )
   {
-	  dxError = device->SetTransform( D3DTRANSFORMSTATE_VIEW, (D3DMATRIX*) &mat );
-	  LOG_DXERR( ("device->SetTransform: view.") );
+    if (device)
+    {
+	    dxError = device->SetTransform( D3DTRANSFORMSTATE_VIEW, (D3DMATRIX*) &mat );
+	    LOG_DXERR( ("device->SetTransform: view.") );
+    }
   }
   //----------------------------------------------------------------------------
 
@@ -162,8 +168,11 @@ namespace Vid
 
   void SetProjTransform_D3D( const Matrix & mat )
   {
-	  dxError = device->SetTransform( D3DTRANSFORMSTATE_PROJECTION, (D3DMATRIX*) &mat );
-	  LOG_DXERR( ("device->SetTransform: project.") );
+    if (device)
+    {
+	    dxError = device->SetTransform( D3DTRANSFORMSTATE_PROJECTION, (D3DMATRIX*) &mat );
+	    LOG_DXERR( ("device->SetTransform: project.") );
+    }
   }
   //----------------------------------------------------------------------------
 
@@ -612,7 +621,7 @@ namespace Vid
     ColorF32 & diffuse = BucketMan::GetMaterial()->Diffuse();
 
     // calculate the parts of the diffuse color that are the same for all output vertexes
-    ColorF32 diff, spec, diffInit
+    ColorF32 * diff, * spec, diffInit
     (
       diffuse.r * renderState.ambientColorF32.r,
       diffuse.g * renderState.ambientColorF32.g,
@@ -620,16 +629,14 @@ namespace Vid
       diffuse.a
     );
 
-    for (VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcN++, srcC++)
-    {
-      // calculate lighting
-      diff = diffInit;
-
-      Vid::Light::LightModel( dstV->vv, *srcN, diffuse, *BucketMan::GetMaterial(), diff, spec);
+    // light the whole batch, then fill the verts
+    Vid::Light::LightModel( &dstV->vv, sizeof(VertexTL), srcN, countV, diffuse, *BucketMan::GetMaterial(), diffInit, diff, spec);
 
+    for (VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcN++, srcC++, diff++, spec++)
+    {
       // set the colors
-      dstV->diffuse.ModulateInline( *srcC, diff.r, diff.g, diff.b, diffuse.a);
-      dstV->specular.SetInline( spec.r, spec.g, spec.b, (U32) 255);
+      dstV->diffuse.ModulateInline( *srcC, diff->r, diff->g, diff->b, diffuse.a);
+      dstV->specular.SetInline( spec->r, spec->g, spec->b, (U32) 255);
 
       TransformFromModel( *dstV);
 	  }
@@ -644,7 +651,7 @@ namespace Vid
     ColorF32 & diffuse = BucketMan::GetMaterial()->Diffuse();
 
     // calculate the parts of the diffuse color that are the same for all output vertexes
-    ColorF32 diff, spec, diffInit
+    ColorF32 * diff, * spec, diffInit
     (
       diffuse.r * renderState.ambientColorF32.r,
       diffuse.g * renderState.ambientColorF32.g,
@@ -652,16 +659,14 @@ namespace Vid
       diffuse.a
     );
 
-    for ( VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcN++)
-    {
-      // calculate lighting
-      diff = diffInit;
-
-      Vid::Light::LightModel( dstV->vv, *srcN, diffuse, *BucketMan::GetMaterial(), diff, spec);
+    // light the whole batch, then fill the verts
+    Vid::Light::LightModel( &dstV->vv, sizeof(VertexTL), srcN, countV, diffuse, *BucketMan::GetMaterial(), diffInit, diff, spec);
 
+    for ( VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcN++, diff++, spec++)
+    {
       // set the colors
-      dstV->diffuse.SetInline( diff.r, diff.g, diff.b, diffuse.a);
-      dstV->specular.SetInline( spec.r, spec.g, spec.b, (U32) 255);
+      dstV->diffuse.SetInline( diff->r, diff->g, diff->b, diffuse.a);
+      dstV->specular.SetInline( spec->r, spec->g, spec->b, (U32) 255);
 
       TransformFromModel( *dstV);
 	  }
@@ -676,7 +681,7 @@ namespace Vid
     ColorF32 & diffuse = BucketMan::GetMaterial()->Diffuse();
 
     // calculate the parts of the diffuse color that are the same for all output vertexes
-    ColorF32 diff, spec, diffInit
+    ColorF32 * diff, * spec, diffInit
     (
       diffuse.r * renderState.ambientColorF32.r,
       diffuse.g * renderState.ambientColorF32.g,
@@ -684,16 +689,14 @@ namespace Vid
       diffuse.a
     );
 
-    for (VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcV++, srcN++, srcC++)
-    {
-      // calculate lighting
-      diff = diffInit;
-
-      Vid::Light::LightModel( *srcV, *srcN, diffuse, *BucketMan::GetMaterial(), diff, spec);
+    // light the whole batch, then fill the verts
+    Vid::Light::LightModel( srcV, sizeof(Vector), srcN, countV, diffuse, *BucketMan::GetMaterial(), diffInit, diff, spec);
 
+    for (VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcV++, srcN++, srcC++, diff++, spec++)
+    {
       // set the colors
-      dstV->diffuse.ModulateInline( *srcC, diff.r, diff.g, diff.b, diffuse.a);
-      dstV->specular.SetInline( spec.r, spec.g, spec.b, (U32) 255);
+      dstV->diffuse.ModulateInline( *srcC, diff->r, diff->g, diff->b, diffuse.a);
+      dstV->specular.SetInline( spec->r, spec->g, spec->b, (U32) 255);
 
       TransformFromModel( *dstV, *srcV);
 	  }
@@ -708,7 +711,7 @@ namespace Vid
     ColorF32 & diffuse = BucketMan::GetMaterial()->Diffuse();
 
     // calculate the parts of the diffuse color that are the same for all output vertexes
-    ColorF32 diff, spec, diffInit
+    ColorF32 * diff, * spec, diffInit
     (
       diffuse.r * renderState.ambientColorF32.r,
       diffuse.g * renderState.ambientColorF32.g,
@@ -716,16 +719,14 @@ namespace Vid
       diffuse.a
     );
 
-    for ( VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcV++, srcN++)
-    {
-      // calculate lighting
-      diff = diffInit;
-
-      Vid::Light::LightModel( *srcV, *srcN, diffuse, *BucketMan::GetMaterial(), diff, spec);
+    // light the whole batch, then fill the verts
+    Vid::Light::LightModel( srcV, sizeof(Vector), srcN, countV, diffuse, *BucketMan::GetMaterial(), diffInit, diff, spec);
 
+    for ( VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcV++, srcN++, diff++, spec++)
+    {
       // set the colors
-      dstV->diffuse.SetInline( diff.r, diff.g, diff.b, diffuse.a);
-      dstV->specular.SetInline( spec.r, spec.g, spec.b, (U32) 255);
+      dstV->diffuse.SetInline( diff->r, diff->g, diff->b, diffuse.a);
+      dstV->specular.SetInline( spec->r, spec->g, spec->b, (U32) 255);
 
       TransformFromModel( *dstV, *srcV);
 	  }
@@ -740,7 +741,7 @@ namespace Vid
     ColorF32 & diffuse = BucketMan::GetMaterial()->Diffuse();
 
     // calculate the parts of the diffuse color that are the same for all output vertexes
-    ColorF32 diff, spec, diffInit
+    ColorF32 * diff, * spec, diffInit
     (
       diffuse.r * renderState.ambientColorF32.r,
       diffuse.g * renderState.ambientColorF32.g,
@@ -748,16 +749,14 @@ namespace Vid
       diffuse.a
     );
 
-    for ( VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcN++, srcC++)
-    {
-      // calculate lighting
-      diff = diffInit;
-
-      Vid::Light::LightModel( dstV->vv, *srcN, diffuse, *BucketMan::GetMaterial(), diff, spec);
+    // light the whole batch, then fill the verts
+    Vid::Light::LightModel( &dstV->vv, sizeof(VertexTL), srcN, countV, diffuse, *BucketMan::GetMaterial(), diffInit, diff, spec);
 
+    for ( VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcN++, srcC++, diff++, spec++)
+    {
       // set the colors
-      dstV->diffuse.ModulateInline( *srcC, diff.r, diff.g, diff.b, diffuse.a);
-      dstV->specular.SetInline( spec.r, spec.g, spec.b, (U32) 255);
+      dstV->diffuse.ModulateInline( *srcC, diff->r, diff->g, diff->b, diffuse.a);
+      dstV->specular.SetInline( spec->r, spec->g, spec->b, (U32) 255);
 
       ProjectFromModel_I( *dstV);
 
@@ -774,7 +773,7 @@ namespace Vid
     ColorF32 & diffuse = BucketMan::GetMaterial()->Diffuse();
 
     // calculate the parts of the diffuse color that are the same for all output vertexes
-    ColorF32 diff, spec, diffInit
+    ColorF32 * diff, * spec, diffInit
     (
       diffuse.r * renderState.ambientColorF32.r,
       diffuse.g * renderState.ambientColorF32.g,
@@ -782,16 +781,14 @@ namespace Vid
       diffuse.a
     );
 
-    for ( VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcN++)
-    {
-      // calculate lighting
-      diff = diffInit;
-
-      Vid::Light::LightModel( dstV->vv, *srcN, diffuse, *BucketMan::GetMaterial(), diff, spec);
+    // light the whole batch, then fill the verts
+    Vid::Light::LightModel( &dstV->vv, sizeof(VertexTL), srcN, countV, diffuse, *BucketMan::GetMaterial(), diffInit, diff, spec);
 
+    for ( VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcN++, diff++, spec++)
+    {
       // set the colors
-      dstV->diffuse.SetInline( diff.r, diff.g, diff.b, diffuse.a);
-      dstV->specular.SetInline( spec.r, spec.g, spec.b, (U32) 255);
+      dstV->diffuse.SetInline( diff->r, diff->g, diff->b, diffuse.a);
+      dstV->specular.SetInline( spec->r, spec->g, spec->b, (U32) 255);
 
       ProjectFromModel_I( *dstV);
 
@@ -808,7 +805,7 @@ namespace Vid
     ColorF32 & diffuse = BucketMan::GetMaterial()->Diffuse();
 
     // calculate the parts of the diffuse color that are the same for all output vertexes
-    ColorF32 diff, spec, diffInit
+    ColorF32 * diff, * spec, diffInit
     (
       diffuse.r * renderState.ambientColorF32.r,
       diffuse.g * renderState.ambientColorF32.g,
@@ -816,16 +813,14 @@ namespace Vid
       diffuse.a
     );
 
-    for ( VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcV++, srcN++, srcC++)
-    {
-      // calculate lighting
-      diff = diffInit;
-
-      Vid::Light::LightModel( *srcV, *srcN, diffuse, *BucketMan::GetMaterial(), diff, spec);
+    // light the whole batch, then fill the verts
+    Vid::Light::LightModel( srcV, sizeof(Vector), srcN, countV, diffuse, *BucketMan::GetMaterial(), diffInit, diff, spec);
 
+    for ( VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcV++, srcN++, srcC++, diff++, spec++)
+    {
       // set the colors
-      dstV->diffuse.ModulateInline( *srcC, diff.r, diff.g, diff.b, diffuse.a);
-      dstV->specular.SetInline( spec.r, spec.g, spec.b, (U32) 255);
+      dstV->diffuse.ModulateInline( *srcC, diff->r, diff->g, diff->b, diffuse.a);
+      dstV->specular.SetInline( spec->r, spec->g, spec->b, (U32) 255);
 
       ProjectFromModel_I( *dstV, *srcV);
 
@@ -842,7 +837,7 @@ namespace Vid
     ColorF32 & diffuse = BucketMan::GetMaterial()->Diffuse();
 
     // calculate the parts of the diffuse color that are the same for all output vertexes
-    ColorF32 diff, spec, diffInit
+    ColorF32 * diff, * spec, diffInit
     (
       diffuse.r * renderState.ambientColorF32.r,
       diffuse.g * renderState.ambientColorF32.g,
@@ -850,16 +845,14 @@ namespace Vid
       diffuse.a
     );
 
-    for ( VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcV++, srcN++)
-    {
-      // calculate lighting
-      diff = diffInit;
-
-      Vid::Light::LightModel( *srcV, *srcN, diffuse, *BucketMan::GetMaterial(), diff, spec);
+    // light the whole batch, then fill the verts
+    Vid::Light::LightModel( srcV, sizeof(Vector), srcN, countV, diffuse, *BucketMan::GetMaterial(), diffInit, diff, spec);
 
+    for ( VertexTL * ev = dstV + countV; dstV < ev; dstV++, srcV++, srcN++, diff++, spec++)
+    {
       // set the colors
-      dstV->diffuse.SetInline( diff.r, diff.g, diff.b, diffuse.a);
-      dstV->specular.SetInline( spec.r, spec.g, spec.b, (U32) 255);
+      dstV->diffuse.SetInline( diff->r, diff->g, diff->b, diffuse.a);
+      dstV->specular.SetInline( spec->r, spec->g, spec->b, (U32) 255);
 
       ProjectFromModel_I( *dstV, *srcV);
 
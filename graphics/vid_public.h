@@ -46,6 +46,80 @@ namespace Vid
   };
   //-----------------------------------------------------------------------------
 
+  // software rasterizer backend
+  //
+  namespace Soft
+  {
+    void Init();
+    void Done();
+
+    Bool IsActive();
+
+    void Begin();
+    void End();
+    void Flush();
+    void Clear( U32 clearFlags, Color color, const Area<S32> * rect = NULL);
+
+    Bool DrawPrimitive( 
+		  PRIMITIVE_TYPE prim_type,
+		  VERTEX_TYPE vert_type,
+		  LPVOID verts,
+		  DWORD vert_count,
+		  DWORD flags);
+
+    Bool DrawIndexedPrimitive( 
+		  PRIMITIVE_TYPE prim_type,
+		  VERTEX_TYPE vert_type,
+		  LPVOID verts,
+		  DWORD vert_count,
+		  LPWORD indices,
+		  DWORD index_count,
+		  DWORD flags);
+
+    Bool Save( const char * filename);
+    void Report();
+  }
+  //-----------------------------------------------------------------------------
+
+  // frame time governor
+  // steers mesh, terrain, particle and shadow detail toward a target frame time
+  //
+  namespace Governor
+  {
+    enum Stage
+    {
+      stageTERRAIN,
+      stageMESH,
+      stagePARTICLE,
+      stageINTERFACE,
+      stageCOUNT
+    };
+
+    void Init();
+    void Done();
+
+    Bool IsActive();
+
+    // bracket a render stage; may be called more than once a frame
+    void Start( U32 stage);
+    void Stop( U32 stage);
+
+    // work units for a stage this frame: visible ents, live particles, ...
+    void SetLoad( U32 stage, U32 load);
+
+    // once per displayed frame
+    void Update();
+
+    // restore the user's settings
+    void Reset();
+
+    // current quantized shadow detail scale
+    F32 ShadowLevel();
+
+    void Report();
+  };
+  //-----------------------------------------------------------------------------
+
   extern U32                  extraFog;
 
   // statistics
@@ -410,8 +484,6 @@ namespace Vid
 
   inline void RenderClear( U32 clearFlags, Color color, Area<S32> * rect = NULL)
   {
-    color;
-
     Area<S32> temp;
     if (!rect)
     {
@@ -419,6 +491,12 @@ namespace Vid
       rect = &temp;
     }
 
+    if (Soft::IsActive())
+    {
+      Soft::Clear( clearFlags, color, rect);
+      return;
+    }
+
     dxError = Vid::device->Clear( 1UL, (LPD3DRECT) rect, clearFlags, color, 1, 0);
 	  LOG_DXERR( ("Vid::ClearD3D: viewport->Clear2") );
   }
@@ -0,0 +1,749 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1997-2000 Pandemic Studios, Dark Reign II
+//
+// vid_soft.cpp       software rasterizer backend
+//
+// 19-OCT-2026
+//
+// When active, the primitive stream is rasterized into an offscreen
+// framebuffer instead of being handed to the d3d device.
+// Transformed (TL) triangles only; gouraud diffuse + specular, z test, blending.
+// Output doesn't depend on the number of worker threads.
+// With -softvid Vid::Init creates no dd/d3d device and this is always active.
+//
+
+#include "vid_private.h"
+#include "console.h"
+#include "system.h"
+#include "clock.h"
+//-----------------------------------------------------------------------------
+
+namespace Vid
+{
+  namespace Soft
+  {
+    const U32 MAXTRIS         = 8192;     // queued triangles before a forced flush
+    const U32 MAXWORKERS      = 4;
+    const S32 SUBBITS         = 4;        // 28.4 fixed point screen coords
+    const S32 SUBPIXEL        = 1 << SUBBITS;
+
+    enum TriFlags
+    {
+      triZTEST    = 0x0001,
+      triZWRITE   = 0x0002,
+      triBLEND    = 0x0004,
+      triSPECULAR = 0x0008,
+    };
+
+    // a set up triangle
+    //
+    struct Tri
+    {
+      S32 x[3], y[3];                     // 28.4 fixed point, positive area winding
+      S32 minX, minY, maxX, maxY;         // inclusive pixel bounds
+
+      // attribute planes: a = a0 + dadx * px + dady * py
+      F32 z0, zdx, zdy;
+      F32 c0[8], cdx[8], cdy[8];          // diffuse rgba, specular rgb
+
+      U32 flags;
+      U32 srcBlend, dstBlend;
+    };
+
+    struct Stats
+    {
+      U32 calls;
+      U32 tris;
+      U32 culled;                         // degenerate or off screen
+      U32 skipped;                        // unsupported vertex or primitive types
+      U32 pixels;
+      U32 flushes;
+      U32 setupUs;
+      U32 rasterUs;
+      U32 clearUs;
+    };
+
+    // locals
+    static Bool                 sysInit;
+    static VarInteger           active;
+    static VarInteger           workerCount;
+
+    static Tri                  tris[MAXTRIS];
+    static U32                  triCount;
+
+    static Array<U32>           colorBuf;
+    static Array<F32>           depthBuf;
+    static S32                  width, height;
+
+    static Stats                frame, last;
+
+    // band workers
+    //
+    struct Worker
+    {
+      System::Thread *          thread;
+      System::Event             startEvent;
+      System::Event             doneEvent;
+      S32                       y0, y1;
+    };
+    static Worker               workers[MAXWORKERS];
+    static U32                  workersLive;
+    static Bool                 quit;
+
+    static void CmdHandler( U32 pathCrc);
+    //-----------------------------------------------------------------------------
+
+    Bool IsActive()
+    {
+      // always on without a device
+      return sysInit && (*active || Vid::isStatus.softVid);
+    }
+    //-----------------------------------------------------------------------------
+
+    static void Resize( S32 w, S32 h)
+    {
+      if (w == width && h == height && colorBuf.data)
+      {
+        return;
+      }
+      width  = Max<S32>( 1, w);
+      height = Max<S32>( 1, h);
+
+      colorBuf.Alloc( width * height);
+      depthBuf.Alloc( width * height);
+
+      memset( colorBuf.data, 0, colorBuf.size);
+
+      U32 i;
+      for (i = 0; i < depthBuf.count; i++)
+      {
+        depthBuf[i] = 1.0f;
+      }
+    }
+    //-----------------------------------------------------------------------------
+
+    // d3d blend factor for a single channel; values are 0-255
+    //
+    inline S32 BlendFactor( U32 mode, S32 s, S32 sa, S32 d, S32 da)
+    {
+      switch (mode)
+      {
+      case D3DBLEND_ZERO:             return 0;
+      default:
+      case D3DBLEND_ONE:              return 255;
+      case D3DBLEND_SRCCOLOR:         return s;
+      case D3DBLEND_INVSRCCOLOR:      return 255 - s;
+      case D3DBLEND_SRCALPHA:         return sa;
+      case D3DBLEND_INVSRCALPHA:      return 255 - sa;
+      case D3DBLEND_DESTCOLOR:        return d;
+      case D3DBLEND_INVDESTCOLOR:     return 255 - d;
+      case D3DBLEND_DESTALPHA:        return da;
+      case D3DBLEND_INVDESTALPHA:     return 255 - da;
+      case D3DBLEND_SRCALPHASAT:      return Min<S32>( sa, 255 - da);
+      }
+    }
+    //-----------------------------------------------------------------------------
+
+    inline S32 Clamp255( F32 f)
+    {
+      S32 i = (S32) f;
+      return i < 0 ? 0 : i > 255 ? 255 : i;
+    }
+    //-----------------------------------------------------------------------------
+
+    // is the edge from i to j a top or left edge; positive area winding
+    //
+    inline Bool TopLeft( S32 dx, S32 dy)
+    {
+      return (dy == 0 && dx > 0) || dy < 0;
+    }
+    //-----------------------------------------------------------------------------
+
+    // rasterize one triangle into rows [by0, by1]
+    //
+    static U32 RasterTri( const Tri & t, S32 by0, S32 by1)
+    {
+      S32 y0 = Max<S32>( t.minY, by0);
+      S32 y1 = Min<S32>( t.maxY, by1);
+      if (y0 > y1)
+      {
+        return 0;
+      }
+
+      // edge setup
+      S64 ea[3], eb[3], ec[3];
+      U32 i;
+      for (i = 0; i < 3; i++)
+      {
+        U32 j = i == 2 ? 0 : i + 1;
+        S32 dx = t.x[j] - t.x[i];
+        S32 dy = t.y[j] - t.y[i];
+
+        // E( px, py) = dx * (py - yi) - dy * (px - xi)
+        ea[i] = -(S64) dy * SUBPIXEL;
+        eb[i] =  (S64) dx * SUBPIXEL;
+        ec[i] =  (S64) dx * ((y0 << SUBBITS) + (SUBPIXEL >> 1) - t.y[i])
+              -  (S64) dy * ((t.minX << SUBBITS) + (SUBPIXEL >> 1) - t.x[i])
+              - (TopLeft( dx, dy) ? 0 : 1);
+      }
+
+      U32 pixels = 0;
+      S32 y, x;
+      for (y = y0; y <= y1; y++, ec[0] += eb[0], ec[1] += eb[1], ec[2] += eb[2])
+      {
+        S64 e0 = ec[0], e1 = ec[1], e2 = ec[2];
+
+        F32 fy = (F32) y + 0.5f;
+        F32 fx = (F32) t.minX + 0.5f;
+
+        F32 z = t.z0 + t.zdx * fx + t.zdy * fy;
+        F32 c[7];
+        for (i = 0; i < 7; i++)
+        {
+          c[i] = t.c0[i] + t.cdx[i] * fx + t.cdy[i] * fy;
+        }
+
+        U32 * dst = colorBuf.data + y * width;
+        F32 * dep = depthBuf.data + y * width;
+
+        for (x = t.minX; x <= t.maxX; x++, e0 += ea[0], e1 += ea[1], e2 += ea[2])
+        {
+          if ((e0 | e1 | e2) >= 0)
+          {
+            if (!(t.flags & triZTEST) || z <= dep[x])
+            {
+              S32 r = Clamp255( c[0]);
+              S32 g = Clamp255( c[1]);
+              S32 b = Clamp255( c[2]);
+              S32 a = Clamp255( c[3]);
+
+              if (t.flags & triSPECULAR)
+              {
+                r = Min<S32>( 255, r + Clamp255( c[4]));
+                g = Min<S32>( 255, g + Clamp255( c[5]));
+                b = Min<S32>( 255, b + Clamp255( c[6]));
+              }
+
+              if (t.flags & triBLEND)
+              {
+                Color d( dst[x]);
+
+                r = Min<S32>( 255, (r * BlendFactor( t.srcBlend, r, a, d.r, d.a) + d.r * BlendFactor( t.dstBlend, r, a, d.r, d.a)) / 255);
+                g = Min<S32>( 255, (g * BlendFactor( t.srcBlend, g, a, d.g, d.a) + d.g * BlendFactor( t.dstBlend, g, a, d.g, d.a)) / 255);
+                b = Min<S32>( 255, (b * BlendFactor( t.srcBlend, b, a, d.b, d.a) + d.b * BlendFactor( t.dstBlend, b, a, d.b, d.a)) / 255);
+                a = Min<S32>( 255, (a * BlendFactor( t.srcBlend, a, a, d.a, d.a) + d.a * BlendFactor( t.dstBlend, a, a, d.a, d.a)) / 255);
+              }
+              dst[x] = (U32(a) << 24) | (U32(r) << 16) | (U32(g) << 8) | U32(b);
+
+              if (t.flags & triZWRITE)
+              {
+                dep[x] = z;
+              }
+              pixels++;
+            }
+          }
+          z += t.zdx;
+          for (i = 0; i < 7; i++)
+          {
+            c[i] += t.cdx[i];
+          }
+        }
+      }
+      return pixels;
+    }
+    //-----------------------------------------------------------------------------
+
+    // rasterize the whole queue into rows [y0, y1]
+    // each row is only touched by one band, in submission order
+    //
+    static U32 RasterBand( S32 y0, S32 y1)
+    {
+      U32 pixels = 0;
+
+      Tri * t, * te = tris + triCount;
+      for (t = tris; t < te; t++)
+      {
+        pixels += RasterTri( *t, y0, y1);
+      }
+      return pixels;
+    }
+    //-----------------------------------------------------------------------------
+
+    static U32 bandPixels[MAXWORKERS];
+
+    static U32 STDCALL Process( void * context)
+    {
+      U32 index = (U32) context;
+      Worker & w = workers[index];
+
+      for (;;)
+      {
+        w.startEvent.Wait();
+
+        if (quit)
+        {
+          break;
+        }
+        bandPixels[index] = RasterBand( w.y0, w.y1);
+
+        w.doneEvent.Signal();
+      }
+      return 0;
+    }
+    //-----------------------------------------------------------------------------
+
+    // rasterize everything queued
+    //
+    void Flush()
+    {
+      if (!triCount)
+      {
+        return;
+      }
+      U32 start = Clock::Time::UsLwr();
+
+      U32 used = Min<U32>( workersLive, *workerCount);
+      if (used && height > (S32) (used + 1))
+      {
+        // split the screen into used + 1 bands; the last one is done here
+        S32 bandHeight = height / (used + 1);
+
+        U32 i;
+        for (i = 0; i < used; i++)
+        {
+          workers[i].y0 = i * bandHeight;
+          workers[i].y1 = workers[i].y0 + bandHeight - 1;
+          workers[i].startEvent.Signal();
+        }
+        frame.pixels += RasterBand( used * bandHeight, height - 1);
+
+        for (i = 0; i < used; i++)
+        {
+          workers[i].doneEvent.Wait();
+          frame.pixels += bandPixels[i];
+        }
+      }
+      else
+      {
+        frame.pixels += RasterBand( 0, height - 1);
+      }
+
+      triCount = 0;
+      frame.flushes++;
+      frame.rasterUs += Clock::Time::UsLwr() - start;
+    }
+    //-----------------------------------------------------------------------------
+
+    // set up an attribute plane from the three vertex values
+    //
+    inline void SetPlane( F32 a0, F32 a1, F32 a2, const F32 * fx, const F32 * fy, F32 invArea, F32 & base, F32 & dx, F32 & dy)
+    {
+      F32 d1 = a1 - a0, d2 = a2 - a0;
+
+      dx = (d1 * (fy[2] - fy[0]) - d2 * (fy[1] - fy[0])) * invArea;
+      dy = (d2 * (fx[1] - fx[0]) - d1 * (fx[2] - fx[0])) * invArea;
+      base = a0 - dx * fx[0] - dy * fy[0];
+    }
+    //-----------------------------------------------------------------------------
+
+    static void SetupTri( const VertexTL & v0, const VertexTL & v1, const VertexTL & v2, U32 triFlags, U32 flags)
+    {
+      frame.tris++;
+
+      const VertexTL * v[3] = { &v0, &v1, &v2 };
+
+      S32 x[3], y[3];
+      U32 i;
+      for (i = 0; i < 3; i++)
+      {
+        x[i] = (S32) (v[i]->vv.x * (F32) SUBPIXEL + 0.5f);
+        y[i] = (S32) (v[i]->vv.y * (F32) SUBPIXEL + 0.5f);
+      }
+
+      S64 area = (S64) (x[1] - x[0]) * (y[2] - y[0]) - (S64) (x[2] - x[0]) * (y[1] - y[0]);
+      if (area == 0)
+      {
+        frame.culled++;
+        return;
+      }
+      if (area < 0)
+      {
+        // tl verts aren't culled; flip to positive winding
+        const VertexTL * tv = v[1]; v[1] = v[2]; v[2] = tv;
+        S32 t;
+        t = x[1]; x[1] = x[2]; x[2] = t;
+        t = y[1]; y[1] = y[2]; y[2] = t;
+        area = -area;
+      }
+
+      S32 minX = Max<S32>( 0,          Min<S32>( x[0], Min<S32>( x[1], x[2])) >> SUBBITS);
+      S32 minY = Max<S32>( 0,          Min<S32>( y[0], Min<S32>( y[1], y[2])) >> SUBBITS);
+      S32 maxX = Min<S32>( width  - 1, Max<S32>( x[0], Max<S32>( x[1], x[2])) >> SUBBITS);
+      S32 maxY = Min<S32>( height - 1, Max<S32>( y[0], Max<S32>( y[1], y[2])) >> SUBBITS);
+
+      if (minX > maxX || minY > maxY)
+      {
+        frame.culled++;
+        return;
+      }
+
+      if (triCount == MAXTRIS)
+      {
+        Flush();
+      }
+      Tri & t = tris[triCount++];
+
+      for (i = 0; i < 3; i++)
+      {
+        t.x[i] = x[i];
+        t.y[i] = y[i];
+      }
+      t.minX = minX;
+      t.minY = minY;
+      t.maxX = maxX;
+      t.maxY = maxY;
+
+      // planes are built from the snapped positions
+      F32 fx[3], fy[3];
+      for (i = 0; i < 3; i++)
+      {
+        fx[i] = (F32) x[i] * (1.0f / (F32) SUBPIXEL);
+        fy[i] = (F32) y[i] * (1.0f / (F32) SUBPIXEL);
+      }
+      F32 invArea = (F32) (SUBPIXEL * SUBPIXEL) / (F32) area;
+
+      SetPlane( v[0]->vv.z, v[1]->vv.z, v[2]->vv.z, fx, fy, invArea, t.z0, t.zdx, t.zdy);
+
+      SetPlane( v[0]->diffuse.r,  v[1]->diffuse.r,  v[2]->diffuse.r,  fx, fy, invArea, t.c0[0], t.cdx[0], t.cdy[0]);
+      SetPlane( v[0]->diffuse.g,  v[1]->diffuse.g,  v[2]->diffuse.g,  fx, fy, invArea, t.c0[1], t.cdx[1], t.cdy[1]);
+      SetPlane( v[0]->diffuse.b,  v[1]->diffuse.b,  v[2]->diffuse.b,  fx, fy, invArea, t.c0[2], t.cdx[2], t.cdy[2]);
+      SetPlane( v[0]->diffuse.a,  v[1]->diffuse.a,  v[2]->diffuse.a,  fx, fy, invArea, t.c0[3], t.cdx[3], t.cdy[3]);
+      SetPlane( v[0]->specular.r, v[1]->specular.r, v[2]->specular.r, fx, fy, invArea, t.c0[4], t.cdx[4], t.cdy[4]);
+      SetPlane( v[0]->specular.g, v[1]->specular.g, v[2]->specular.g, fx, fy, invArea, t.c0[5], t.cdx[5], t.cdy[5]);
+      SetPlane( v[0]->specular.b, v[1]->specular.b, v[2]->specular.b, fx, fy, invArea, t.c0[6], t.cdx[6], t.cdy[6]);
+
+      t.flags    = triFlags;
+      t.srcBlend = (flags & RS_SRC_MASK) >> RS_SRC_SHIFT;
+      t.dstBlend = (flags & RS_DST_MASK) >> RS_DST_SHIFT;
+    }
+    //-----------------------------------------------------------------------------
+
+    // per call state shared by all the call's triangles
+    //
+    static U32 TriFlags( U32 flags)
+    {
+      U32 triFlags = 0;
+
+      if (renderState.status.zbuffer && !(flags & RS_NOZBUFFER))
+      {
+        triFlags |= triZTEST;
+      }
+      if (renderState.status.alpha && (flags & (RS_SRC_MASK | RS_DST_MASK)))
+      {
+        triFlags |= triBLEND;
+      }
+      else if (triFlags & triZTEST)
+      {
+        triFlags |= triZWRITE;
+      }
+      if (renderState.status.specular)
+      {
+        triFlags |= triSPECULAR;
+      }
+      return triFlags;
+    }
+    //-----------------------------------------------------------------------------
+
+    Bool DrawIndexedPrimitive(
+	    PRIMITIVE_TYPE prim_type,
+	    VERTEX_TYPE vert_type,
+	    LPVOID verts,
+	    DWORD vert_count,
+	    LPWORD indices,
+	    DWORD index_count,
+	    DWORD flags)
+    {
+      frame.calls++;
+
+      if (vert_type != FVF_TLVERTEX)
+      {
+        frame.skipped++;
+        return TRUE;
+      }
+      U32 start = Clock::Time::UsLwr();
+
+      const VertexTL * v = (const VertexTL *) verts;
+      U32 triFlags = TriFlags( flags);
+
+      // non-indexed calls walk the verts in order
+      U32 count = indices ? index_count : vert_count;
+      #define VERT(n) v[indices ? indices[n] : (n)]
+
+      U32 i;
+      switch (prim_type)
+      {
+      case PT_TRIANGLELIST:
+        for (i = 0; i + 2 < count; i += 3)
+        {
+          SetupTri( VERT(i), VERT(i + 1), VERT(i + 2), triFlags, flags);
+        }
+        break;
+      case PT_TRIANGLESTRIP:
+        for (i = 0; i + 2 < count; i++)
+        {
+          SetupTri( VERT(i), VERT(i + 1), VERT(i + 2), triFlags, flags);
+        }
+        break;
+      case PT_TRIANGLEFAN:
+        for (i = 1; i + 1 < count; i++)
+        {
+          SetupTri( VERT(0), VERT(i), VERT(i + 1), triFlags, flags);
+        }
+        break;
+      default:
+        frame.skipped++;
+        break;
+      }
+      #undef VERT
+
+      frame.setupUs += Clock::Time::UsLwr() - start;
+
+      indexCount += count;
+
+      return TRUE;
+    }
+    //-----------------------------------------------------------------------------
+
+    Bool DrawPrimitive(
+	    PRIMITIVE_TYPE prim_type,
+	    VERTEX_TYPE vert_type,
+	    LPVOID verts,
+	    DWORD vert_count,
+	    DWORD flags)
+    {
+      return DrawIndexedPrimitive( prim_type, vert_type, verts, vert_count, NULL, 0, flags);
+    }
+    //-----------------------------------------------------------------------------
+
+    void Clear( U32 clearFlags, Color color, const Area<S32> * rect) // = NULL
+    {
+      Flush();
+
+      U32 start = Clock::Time::UsLwr();
+
+      S32 x0 = 0, y0 = 0, x1 = width, y1 = height;
+      if (rect)
+      {
+        x0 = Max<S32>( 0, rect->p0.x);
+        y0 = Max<S32>( 0, rect->p0.y);
+        x1 = Min<S32>( width,  rect->p1.x);
+        y1 = Min<S32>( height, rect->p1.y);
+      }
+
+      S32 x, y;
+      for (y = y0; y < y1; y++)
+      {
+        if (clearFlags & clearBACK)
+        {
+          U32 * dst = colorBuf.data + y * width;
+          for (x = x0; x < x1; x++)
+          {
+            dst[x] = color.color;
+          }
+        }
+        if (clearFlags & clearZBUFFER)
+        {
+          F32 * dst = depthBuf.data + y * width;
+          for (x = x0; x < x1; x++)
+          {
+            dst[x] = 1.0f;
+          }
+        }
+      }
+      frame.clearUs += Clock::Time::UsLwr() - start;
+    }
+    //-----------------------------------------------------------------------------
+
+    void Begin()
+    {
+      Resize( viewRect.p1.x, viewRect.p1.y);
+
+      // workers are started on first use and live until Done
+      while (workersLive < (U32) *workerCount)
+      {
+        workers[workersLive].thread = new System::Thread( Process, (void *) workersLive);
+        workersLive++;
+      }
+
+      Utils::Memset( &frame, 0, sizeof( frame));
+    }
+    //-----------------------------------------------------------------------------
+
+    void End()
+    {
+      Flush();
+
+      last = frame;
+    }
+    //-----------------------------------------------------------------------------
+
+    // write the framebuffer out as a 24 bit .bmp
+    //
+    Bool Save( const char * filename)
+    {
+      Flush();
+
+      if (!colorBuf.data)
+      {
+        return FALSE;
+      }
+
+      FILE * fp = fopen( filename, "wb");
+      if (!fp)
+      {
+        return FALSE;
+      }
+
+      U32 lineBytes = (width * 3 + 3) & ~3;
+
+      BITMAPFILEHEADER fileHeader;
+      BITMAPINFOHEADER infoHeader;
+
+      fileHeader.bfType       = 0x4D42;
+      fileHeader.bfSize       = sizeof( fileHeader) + sizeof( infoHeader) + lineBytes * height;
+      fileHeader.bfReserved1  = 0;
+      fileHeader.bfReserved2  = 0;
+      fileHeader.bfOffBits    = sizeof( fileHeader) + sizeof( infoHeader);
+
+      infoHeader.biSize           = sizeof( BITMAPINFOHEADER);
+      infoHeader.biWidth          = width;
+      infoHeader.biHeight         = height;
+      infoHeader.biPlanes         = 1;
+      infoHeader.biBitCount       = 24;
+      infoHeader.biCompression    = BI_RGB;
+      infoHeader.biSizeImage      = 0;
+      infoHeader.biXPelsPerMeter  = 0;
+      infoHeader.biYPelsPerMeter  = 0;
+      infoHeader.biClrUsed        = 0;
+      infoHeader.biClrImportant   = 0;
+
+      fwrite( &fileHeader, sizeof( fileHeader), 1, fp);
+      fwrite( &infoHeader, sizeof( infoHeader), 1, fp);
+
+      U8 * line = new U8[lineBytes];
+      memset( line, 0, lineBytes);
+
+      // bottom up
+      S32 x, y;
+      for (y = height - 1; y >= 0; y--)
+      {
+        const U32 * src = colorBuf.data + y * width;
+        U8 * dst = line;
+        for (x = 0; x < width; x++, src++)
+        {
+          *dst++ = (U8) (*src);
+          *dst++ = (U8) (*src >> 8);
+          *dst++ = (U8) (*src >> 16);
+        }
+        fwrite( line, lineBytes, 1, fp);
+      }
+      delete [] line;
+
+      fclose( fp);
+
+      return TRUE;
+    }
+    //-----------------------------------------------------------------------------
+
+    void Report()
+    {
+      CON_DIAG(( "soft: %dx%d calls %d tris %d culled %d skipped %d pixels %d flushes %d",
+        width, height, last.calls, last.tris, last.culled, last.skipped, last.pixels, last.flushes));
+      CON_DIAG(( "soft: setup %dus raster %dus clear %dus workers %d",
+        last.setupUs, last.rasterUs, last.clearUs, Min<U32>( workersLive, *workerCount)));
+    }
+    //-----------------------------------------------------------------------------
+
+    void Init()
+    {
+      VarSys::RegisterHandler("vid.soft", CmdHandler);
+
+      VarSys::CreateInteger("vid.soft.active", FALSE, VarSys::DEFAULT, &active);
+      VarSys::CreateInteger("vid.soft.workers", 0, VarSys::DEFAULT, &workerCount)->SetIntegerRange(0, MAXWORKERS);
+
+      VarSys::CreateCmd("vid.soft.report");
+      VarSys::CreateCmd("vid.soft.save");
+
+      triCount = 0;
+      width = height = 0;
+
+      Utils::Memset( &frame, 0, sizeof( frame));
+      Utils::Memset( &last,  0, sizeof( last));
+
+      quit = FALSE;
+      workersLive = 0;
+
+      sysInit = TRUE;
+    }
+    //-----------------------------------------------------------------------------
+
+    void Done()
+    {
+      if (!sysInit)
+      {
+        return;
+      }
+
+      quit = TRUE;
+      U32 i;
+      for (i = 0; i < workersLive; i++)
+      {
+        workers[i].startEvent.Signal();
+
+        // waits for the thread to exit
+        delete workers[i].thread;
+        workers[i].thread = NULL;
+      }
+      workersLive = 0;
+
+      colorBuf.Release();
+      depthBuf.Release();
+
+      VarSys::DeleteItem("vid.soft");
+
+      sysInit = FALSE;
+    }
+    //-----------------------------------------------------------------------------
+
+    static void CmdHandler( U32 pathCrc)
+    {
+      switch (pathCrc)
+      {
+      case 0xF09E57B2: // "vid.soft.report"
+        Report();
+        break;
+
+      case 0x29EF5E73: // "vid.soft.save"
+      {
+        static U32 counter = 0;
+        char * s;
+        GameIdent gi;
+        if (!Console::GetArgString(1, s))
+        {
+          sprintf( gi.str, "soft%d.bmp", counter);
+          counter++;
+          s = gi.str;
+        }
+        if (!Save( s))
+        {
+          CON_ERR(( "vid.soft.save: can't write %s", s));
+        }
+        break;
+      }
+      }
+    }
+    //-----------------------------------------------------------------------------
+  }
+}
+//-----------------------------------------------------------------------------
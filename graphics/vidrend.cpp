@@ -96,9 +96,12 @@ namespace Vid
     {
       flag |= D3DZB_USEW;
     }
-    dxError = device->SetRenderState( D3DRENDERSTATE_ZENABLE, flag );
-	  dxError = device->SetRenderState( D3DRENDERSTATE_ZWRITEENABLE, doZBuffer);
-    LOG_DXERR( ("SetZBufferState") );
+    if (device)
+    {
+      dxError = device->SetRenderState( D3DRENDERSTATE_ZENABLE, flag );
+	    dxError = device->SetRenderState( D3DRENDERSTATE_ZWRITEENABLE, doZBuffer);
+      LOG_DXERR( ("SetZBufferState") );
+    }
 
     return retValue;
   }
@@ -106,7 +109,11 @@ namespace Vid
 
   Bool SetZWriteState( Bool doZWrite)
   {
-    U32 retValue;
+    U32 retValue = doZWrite;
+    if (!device)
+    {
+      return (Bool) retValue;
+    }
     device->GetRenderState( D3DRENDERSTATE_ZWRITEENABLE, &retValue);
 
 	  dxError = device->SetRenderState( D3DRENDERSTATE_ZWRITEENABLE, doZWrite);
@@ -118,8 +125,11 @@ namespace Vid
 
   void SetCullStateD3D( Bool doCull)
   {
-    dxError = device->SetRenderState( D3DRENDERSTATE_CULLMODE, doCull ? D3DCULL_CCW : D3DCULL_NONE);
-    LOG_DXERR( ("SetCullState") );
+    if (device)
+    {
+      dxError = device->SetRenderState( D3DRENDERSTATE_CULLMODE, doCull ? D3DCULL_CCW : D3DCULL_NONE);
+      LOG_DXERR( ("SetCullState") );
+    }
   }
   //----------------------------------------------------------------------------
 
@@ -129,8 +139,11 @@ namespace Vid
 
     renderState.status.alpha = doAlpha;
 
-    dxError = device->SetRenderState( D3DRENDERSTATE_ALPHABLENDENABLE, doAlpha);
-    LOG_DXERR( ("device->SetRenderState") );
+    if (device)
+    {
+      dxError = device->SetRenderState( D3DRENDERSTATE_ALPHABLENDENABLE, doAlpha);
+      LOG_DXERR( ("device->SetRenderState") );
+    }
 
     return retValue;
   }
@@ -145,8 +158,11 @@ namespace Vid
     renderState.renderFlags |= flags;
     flags >>= RS_SRC_SHIFT;
 
-    dxError = device->SetRenderState( D3DRENDERSTATE_SRCBLEND, flags);
-    LOG_DXERR( ("SetSrcBlendState") );
+    if (device)
+    {
+      dxError = device->SetRenderState( D3DRENDERSTATE_SRCBLEND, flags);
+      LOG_DXERR( ("SetSrcBlendState") );
+    }
 
     return lastflags;
   }
@@ -161,8 +177,11 @@ namespace Vid
     renderState.renderFlags |= flags;
     flags >>= RS_DST_SHIFT;
 
-    dxError = device->SetRenderState( D3DRENDERSTATE_DESTBLEND, flags);
-    LOG_DXERR( ("SetDstBlendState") );
+    if (device)
+    {
+      dxError = device->SetRenderState( D3DRENDERSTATE_DESTBLEND, flags);
+      LOG_DXERR( ("SetDstBlendState") );
+    }
 
     return lastflags;
   }
@@ -177,9 +196,12 @@ namespace Vid
     U32 flag = flags & RS_ADD_MASK;
     renderState.renderFlags |= flag;
 
-    dxError = device->SetTextureStageState( stage, D3DTSS_ADDRESS, (flag >> RS_ADD_SHIFT) + 1);
+    if (device)
+    {
+      dxError = device->SetTextureStageState( stage, D3DTSS_ADDRESS, (flag >> RS_ADD_SHIFT) + 1);
 
-    LOG_DXERR( ("SetTexWrapState") );
+      LOG_DXERR( ("SetTexWrapState") );
+    }
 
     return lastFlags;
   }
@@ -498,7 +520,10 @@ namespace Vid
     }
 #endif
 
-    blendToOp[ flags](stage);
+    if (device)
+    {
+      blendToOp[ flags](stage);
+    }
 
     return lastflags;
   }
@@ -653,9 +678,12 @@ namespace Vid
 
   void SetTextureFactor( Color color)
   {
-    dxError = device->SetRenderState( D3DRENDERSTATE_TEXTUREFACTOR, 
-      D3DRGBA( color.r, color.g, color.b, color.a) );
-    LOG_DXERR( ("SetTextureFactor") );
+    if (device)
+    {
+      dxError = device->SetRenderState( D3DRENDERSTATE_TEXTUREFACTOR, 
+        D3DRGBA( color.r, color.g, color.b, color.a) );
+      LOG_DXERR( ("SetTextureFactor") );
+    }
   }
   //-----------------------------------------------------------------------------
 
@@ -716,7 +744,10 @@ namespace Vid
 	  viewDesc.dvMinZ			= 0.0f;
 	  viewDesc.dvMaxZ			= 1.0f;
 
-    device->SetViewport( &viewDesc);
+    if (device)
+    {
+      device->SetViewport( &viewDesc);
+    }
 
     Setup( *curCamera);
 
@@ -1003,12 +1034,19 @@ namespace Vid
     bucket.Flush(FALSE);
     tranbucket.Flush(FALSE);
 
+    texMemPerFrame = 0;
+
+    if (Soft::IsActive())
+    {
+      Soft::Begin();
+      return TRUE;
+    }
+
 	  dxError = device->BeginScene();
 	  if (dxError)
 	  {
 		  LOG_DXERR( ("BeginScene: device->BeginScene") );
 	  }
-    texMemPerFrame = 0;
 
     return dxError == DD_OK;
   }
@@ -1077,6 +1115,11 @@ namespace Vid
             DP_DONOTUPDATEEXTENTS | DP_DONOTLIGHT | DP_DONOTCLIP | RS_BLEND_ADD);
     }
 
+    if (Soft::IsActive())
+    {
+      Soft::End();
+      return TRUE;
+    }
 
 	  dxError = device->EndScene();
  	  LOG_DXERR( ("EndScene: device->EndScene") );
@@ -1094,12 +1137,15 @@ namespace Vid
         mat = defMaterial;
 	    }
       Material::Manager::SetMaterial( mat);
+      Statistics::stateChanges++;
 
 		  const MaterialDescD3D & matD3D = mat->GetDesc();
 
-		  dxError = device->SetMaterial( (MaterialDescD3D *) &matD3D);
-		  LOG_DXERR( ("device->SetMaterial") );
-  
+      if (device)
+      {
+		    dxError = device->SetMaterial( (MaterialDescD3D *) &matD3D);
+		    LOG_DXERR( ("device->SetMaterial") );
+      }
     }
   }
   //----------------------------------------------------------------------------
@@ -1111,11 +1157,15 @@ namespace Vid
       if(Bitmap::Manager::GetTexture(stage) != tex)
 	    {
         Bitmap::Manager::SetTexture(tex, stage);
+        Statistics::stateChanges++;
 
         TextureHandle texH = tex ? tex->GetTexture() : NULL;
 
-        dxError = device->SetTexture(stage, texH);
-        LOG_DXERR( ("SetRenderState( mat): device->RenderState( TEXTUREHANDLE)") );
+        if (device)
+        {
+          dxError = device->SetTexture(stage, texH);
+          LOG_DXERR( ("SetRenderState( mat): device->RenderState( TEXTUREHANDLE)") );
+        }
       }
 
       SetTexBlendState( blend, stage);
@@ -1125,7 +1175,10 @@ namespace Vid
         SetTexWrapState( blend, stage);
       }
     }
-    ASSERT( device);
+    if (!device)
+    {
+      return TRUE;
+    }
 
     if (stage > 0)
     {
@@ -1154,6 +1207,10 @@ namespace Vid
 
   Bool SetTextureDX( const Bitmap * tex, U32 stage, U32 blend) // = 0, = RS_BLEND_DEF
   {
+    if (!device)
+    {
+      return TRUE;
+    }
     TextureHandle texH = tex ? tex->GetTexture() : NULL;
 
     dxError = device->SetTexture( stage, texH);
@@ -1238,6 +1295,13 @@ namespace Vid
       ((prim_type == PT_TRIANGLEFAN) && (vert_count >= 3))
     );
 
+    Statistics::drawCalls++;
+
+    if (Soft::IsActive())
+    {
+      return Soft::DrawPrimitive( prim_type, vert_type, verts, vert_count, flags);
+    }
+
     // Check for errors
 	  if (renderState.status.checkVerts && !AreVerticesInRange( (VertexTL *) verts, vert_count, NULL, 0, flags))
     {
@@ -1298,6 +1362,13 @@ namespace Vid
       ((prim_type == PT_TRIANGLEFAN) && (vert_count >= 3))
     );
 
+    Statistics::drawCalls++;
+
+    if (Soft::IsActive())
+    {
+      return Soft::DrawPrimitive( prim_type, vert_type, verts, vert_count, flags);
+    }
+
     // Check for errors
     if (renderState.status.checkVerts && !AreVerticesInRange( (VertexTL *) verts, vert_count, NULL, 0, flags))
     {
@@ -1360,6 +1431,13 @@ namespace Vid
 	    ((prim_type == PT_TRIANGLEFAN) && (index_count >= 3))
 	  );
 
+    Statistics::drawCalls++;
+
+    if (Soft::IsActive())
+    {
+      return Soft::DrawIndexedPrimitive( prim_type, vert_type, verts, vert_count, indices, index_count, flags);
+    }
+
     // Check for errors
 	  if (renderState.status.checkVerts && !AreVerticesInRange( (VertexTL *) verts, vert_count, indices, index_count, flags))
     {
@@ -647,6 +647,10 @@ namespace Main
               Vid::doStatus.tripleBuf = FALSE;    // don't use a triple buffered flip chain
               break;
 
+            case 0xE0ABA2C4: // "softvid"
+              Vid::doStatus.softVid = TRUE;       // no device, software rasterizer only
+              break;
+
             case 0xA16D7A25: // "nofpucheck"
               fpuExceptions = FALSE;
               break;
@@ -66,6 +66,9 @@ namespace PerfStats
   // Maximum number of PerfObj's
   const U32 MAXOBJS = 50;
 
+  // Maximum number of counters
+  const U32 MAXCOUNTERS = 64;
+
   // Is the system initialised
   static Bool sysInit = FALSE;
 
@@ -89,6 +92,19 @@ namespace PerfStats
   static U32 sortedTotal;
   static Bool purge = FALSE;
 
+  // Counters, displayed below the timers
+  struct Counter
+  {
+    StrCrc<32> ident;
+    U32 value;
+    U32 limit;
+  };
+  static Counter counters[MAXCOUNTERS];
+  static U32 counterCount = 0;
+
+  // Has a counter been dropped since the last reset
+  static Bool counterFull = FALSE;
+
   // Current output row for mono
   static U32 monoRow = 1;
 
@@ -141,6 +157,9 @@ namespace PerfStats
   // Format the Performance Statistics into a string
   const char *FormatDisplay(PerfObj &perf);
 
+  // Format a counter into a string
+  const char *FormatCounter(Counter &counter);
+
   // qsort compare function - sort by smoothed average
   int CDECL SortSmooth(const void *elem1, const void *elem2);
 
@@ -236,6 +255,11 @@ namespace PerfStats
     // Log the shit
     DisplayAll(DisplayToLog);
 
+    for (U32 c = 0; c < counterCount; c++)
+    {
+      LOG_DIAG((FormatCounter(counters[c])));
+    }
+
     // Delete all list entries
     objs.DisposeAll();
 
@@ -304,6 +328,46 @@ namespace PerfStats
   }
 
 
+  //
+  // Set a counter, create it if it doesnt exist
+  // if limit is non zero the value is shown as a fraction of it
+  //
+  void Count(const char *s, U32 value, U32 limit) // = 0)
+  {
+    ASSERT(sysInit);
+
+    if (!hwSupport) return;
+
+    U32 crc = Crc::CalcStr(s);
+    U32 i;
+
+    for (i = 0; i < counterCount; i++)
+    {
+      if (counters[i].ident.crc == crc)
+      {
+        break;
+      }
+    }
+
+    if (i == counterCount)
+    {
+      if (counterCount == MAXCOUNTERS)
+      {
+        if (!counterFull)
+        {
+          LOG_WARN(("PerfStats: more than %d counters, [%s] is not reported", MAXCOUNTERS, s));
+          counterFull = TRUE;
+        }
+        return;
+      }
+      counters[counterCount++].ident = s;
+    }
+
+    counters[i].value = value;
+    counters[i].limit = limit;
+  }
+
+
   //
   // Reset all statistics
   //
@@ -322,6 +386,9 @@ namespace PerfStats
 
     // Flags for purge of list on next redraw
     purge = TRUE;
+
+    counterCount = 0;
+    counterFull = FALSE;
   }
 
 
@@ -445,6 +512,14 @@ namespace PerfStats
     monoRow = 1;
     DisplayAll(DisplayToMono);
 
+    // Draw each counter
+    #ifndef MONO_DISABLED
+      for (U32 c = 0; c < counterCount && S32(monoRow) < monoBuffer->Height(); c++)
+      {
+        MonoBufWrite(monoBuffer, monoRow++, 0, FormatCounter(counters[c]), Mono::BRIGHT);
+      }
+    #endif
+
     // Fill to bottom with blanks
     #ifndef MONO_DISABLED
       while (S32(monoRow) < monoBuffer->Height())
@@ -530,6 +605,30 @@ namespace PerfStats
   }
 
 
+  //
+  // Format a counter into a string
+  //
+  const char *FormatCounter(Counter &counter)
+  {
+    static char formatBuf[128];
+
+    if (counter.limit)
+    {
+      Utils::Sprintf
+      (
+        formatBuf, sizeof(formatBuf), "%-18s%11u of %11u %7.2f%%",
+        counter.ident.str, counter.value, counter.limit, F32(counter.value) * 100.0F / F32(counter.limit)
+      );
+    }
+    else
+    {
+      Utils::Sprintf(formatBuf, sizeof(formatBuf), "%-18s%11u", counter.ident.str, counter.value);
+    }
+
+    return formatBuf;
+  }
+
+
   //
   // Sort PerfObj list into the array 'sortedList'
   //
@@ -36,6 +36,9 @@ namespace PerfStats
   // Stop a timer
   void Stop(const char *s);
 
+  // Set a counter, create it if it doesnt exist
+  void Count(const char *s, U32 value, U32 limit = 0);
+
   // Display the performance stats on the mono
   void Display();
 
@@ -58,6 +61,7 @@ namespace PerfStats
 #define PERF_S(s)     PerfStats::Start(s);
 #define PERF_SROOT(s) PerfStats::Start(s, TRUE);
 #define PERF_E(s)     PerfStats::Stop(s);
+#define PERF_COUNT(s, n, l) PerfStats::Count(s, n, l);
 #define PERF_REDRAW   PerfStats::Display();
 
 #if 0
@@ -80,6 +84,7 @@ namespace PerfStats
 #define PERF_S(s)
 #define PERF_SROOT(s)
 #define PERF_E(s)
+#define PERF_COUNT(s, n, l)
 #define PERF_REDRAW
 
 #define PERF_X_S(s)